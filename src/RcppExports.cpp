@@ -11,6 +11,18 @@ Rcpp::Rostream<false>& Rcpp::Rcerr = Rcpp::Rcpp_cerr_get();
 #endif
 
 
+RcppExport SEXP _rcpp_module_boot_OnlineCSNormalEx();
+RcppExport SEXP _rcpp_module_boot_OnlineCSBerEx();
+RcppExport SEXP _rcpp_module_boot_OnlineCSBoundedEx();
+RcppExport SEXP _rcpp_module_boot_StcpBankSTNormalEx();
+RcppExport SEXP _rcpp_module_boot_StcpBankSRNormalEx();
+RcppExport SEXP _rcpp_module_boot_StcpBankCUNormalEx();
+RcppExport SEXP _rcpp_module_boot_StcpBankSTBerEx();
+RcppExport SEXP _rcpp_module_boot_StcpBankSRBerEx();
+RcppExport SEXP _rcpp_module_boot_StcpBankCUBerEx();
+RcppExport SEXP _rcpp_module_boot_StcpBankSTBoundedEx();
+RcppExport SEXP _rcpp_module_boot_StcpBankSRBoundedEx();
+RcppExport SEXP _rcpp_module_boot_StcpBankCUBoundedEx();
 RcppExport SEXP _rcpp_module_boot_HelperEx();
 RcppExport SEXP _rcpp_module_boot_StcpMixESTNormalEx();
 RcppExport SEXP _rcpp_module_boot_StcpMixESRNormalEx();
@@ -27,8 +39,28 @@ RcppExport SEXP _rcpp_module_boot_GLRCUNormalLessEx();
 RcppExport SEXP _rcpp_module_boot_GLRCUBerEx();
 RcppExport SEXP _rcpp_module_boot_GLRCUBerGreaterEx();
 RcppExport SEXP _rcpp_module_boot_GLRCUBerLessEx();
+RcppExport SEXP _rcpp_module_boot_GLRCUApproxNormalEx();
+RcppExport SEXP _rcpp_module_boot_GLRCUApproxNormalGreaterEx();
+RcppExport SEXP _rcpp_module_boot_GLRCUApproxNormalLessEx();
+RcppExport SEXP _rcpp_module_boot_GLRCUApproxBerEx();
+RcppExport SEXP _rcpp_module_boot_GLRCUApproxBerGreaterEx();
+RcppExport SEXP _rcpp_module_boot_GLRCUApproxBerLessEx();
+RcppExport SEXP stcp_update_log_value(SEXP, SEXP);
+RcppExport SEXP stcp_update_log_value_by_avg(SEXP, SEXP, SEXP);
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_rcpp_module_boot_OnlineCSNormalEx", (DL_FUNC) &_rcpp_module_boot_OnlineCSNormalEx, 0},
+    {"_rcpp_module_boot_OnlineCSBerEx", (DL_FUNC) &_rcpp_module_boot_OnlineCSBerEx, 0},
+    {"_rcpp_module_boot_OnlineCSBoundedEx", (DL_FUNC) &_rcpp_module_boot_OnlineCSBoundedEx, 0},
+    {"_rcpp_module_boot_StcpBankSTNormalEx", (DL_FUNC) &_rcpp_module_boot_StcpBankSTNormalEx, 0},
+    {"_rcpp_module_boot_StcpBankSRNormalEx", (DL_FUNC) &_rcpp_module_boot_StcpBankSRNormalEx, 0},
+    {"_rcpp_module_boot_StcpBankCUNormalEx", (DL_FUNC) &_rcpp_module_boot_StcpBankCUNormalEx, 0},
+    {"_rcpp_module_boot_StcpBankSTBerEx", (DL_FUNC) &_rcpp_module_boot_StcpBankSTBerEx, 0},
+    {"_rcpp_module_boot_StcpBankSRBerEx", (DL_FUNC) &_rcpp_module_boot_StcpBankSRBerEx, 0},
+    {"_rcpp_module_boot_StcpBankCUBerEx", (DL_FUNC) &_rcpp_module_boot_StcpBankCUBerEx, 0},
+    {"_rcpp_module_boot_StcpBankSTBoundedEx", (DL_FUNC) &_rcpp_module_boot_StcpBankSTBoundedEx, 0},
+    {"_rcpp_module_boot_StcpBankSRBoundedEx", (DL_FUNC) &_rcpp_module_boot_StcpBankSRBoundedEx, 0},
+    {"_rcpp_module_boot_StcpBankCUBoundedEx", (DL_FUNC) &_rcpp_module_boot_StcpBankCUBoundedEx, 0},
     {"_rcpp_module_boot_HelperEx", (DL_FUNC) &_rcpp_module_boot_HelperEx, 0},
     {"_rcpp_module_boot_StcpMixESTNormalEx", (DL_FUNC) &_rcpp_module_boot_StcpMixESTNormalEx, 0},
     {"_rcpp_module_boot_StcpMixESRNormalEx", (DL_FUNC) &_rcpp_module_boot_StcpMixESRNormalEx, 0},
@@ -45,6 +77,14 @@ static const R_CallMethodDef CallEntries[] = {
     {"_rcpp_module_boot_GLRCUBerEx", (DL_FUNC) &_rcpp_module_boot_GLRCUBerEx, 0},
     {"_rcpp_module_boot_GLRCUBerGreaterEx", (DL_FUNC) &_rcpp_module_boot_GLRCUBerGreaterEx, 0},
     {"_rcpp_module_boot_GLRCUBerLessEx", (DL_FUNC) &_rcpp_module_boot_GLRCUBerLessEx, 0},
+    {"_rcpp_module_boot_GLRCUApproxNormalEx", (DL_FUNC) &_rcpp_module_boot_GLRCUApproxNormalEx, 0},
+    {"_rcpp_module_boot_GLRCUApproxNormalGreaterEx", (DL_FUNC) &_rcpp_module_boot_GLRCUApproxNormalGreaterEx, 0},
+    {"_rcpp_module_boot_GLRCUApproxNormalLessEx", (DL_FUNC) &_rcpp_module_boot_GLRCUApproxNormalLessEx, 0},
+    {"_rcpp_module_boot_GLRCUApproxBerEx", (DL_FUNC) &_rcpp_module_boot_GLRCUApproxBerEx, 0},
+    {"_rcpp_module_boot_GLRCUApproxBerGreaterEx", (DL_FUNC) &_rcpp_module_boot_GLRCUApproxBerGreaterEx, 0},
+    {"_rcpp_module_boot_GLRCUApproxBerLessEx", (DL_FUNC) &_rcpp_module_boot_GLRCUApproxBerLessEx, 0},
+    {"stcp_update_log_value", (DL_FUNC) &stcp_update_log_value, 2},
+    {"stcp_update_log_value_by_avg", (DL_FUNC) &stcp_update_log_value_by_avg, 3},
     {NULL, NULL, 0}
 };
 
@@ -15,6 +15,8 @@ namespace stcp
             "Type must be derived from IBaselineIncrement class.");
 
     public:
+        using BaseType = L;
+
         BaselineE()
             : m_log_value{kNegInf}, m_base_obj{}
         {
@@ -25,6 +27,7 @@ namespace stcp
         }
 
         double getLogValue() override { return m_log_value; }
+        bool isLogValueAbove(const double &log_threshold) override { return m_log_value > log_threshold; }
         void reset() override { m_log_value = kNegInf; }
         virtual void updateLogValue(const double &x) override = 0;
         virtual void updateLogValueByAvg(const double &x_bar, const double &n) override = 0;
@@ -53,11 +56,18 @@ namespace stcp
         void reset() override { this->m_log_value = 0.0; }
         void updateLogValue(const double &x) override
         {
-            this->m_log_value += this->m_base_obj.computeLogBaseValue(x);
+            this->m_log_value = kernelLogValue(this->m_log_value, this->m_base_obj.computeLogBaseValue(x));
         }
         void updateLogValueByAvg(const double &x_bar, const double &n) override
         {
-            this->m_log_value += this->m_base_obj.computeLogBaseValueByAvg(x_bar, n);
+            this->m_log_value = kernelLogValue(this->m_log_value, this->m_base_obj.computeLogBaseValueByAvg(x_bar, n));
+        }
+
+        // Recursion shared with the contiguous arrays of MixBaselineE.
+        static double initialLogValue() { return 0.0; }
+        static double kernelLogValue(const double &log_value, const double &log_base_value)
+        {
+            return log_value + log_base_value;
         }
     };
     template <typename L>
@@ -68,12 +78,35 @@ namespace stcp
         void updateLogValue(const double &x) override
         {
             this->m_log_value =
-                log(1 + exp(this->m_log_value)) + this->m_base_obj.computeLogBaseValue(x);
+                kernelLogValue(this->m_log_value, this->m_base_obj.computeLogBaseValue(x));
         }
         void updateLogValueByAvg(const double &x_bar, const double &n) override
         {
             this->m_log_value =
-                log(1 + exp(this->m_log_value)) + this->m_base_obj.computeLogBaseValueByAvg(x_bar, n);
+                kernelLogValue(this->m_log_value, this->m_base_obj.computeLogBaseValueByAvg(x_bar, n));
+        }
+
+        // Recursion shared with the contiguous arrays of MixBaselineE.
+        static double initialLogValue() { return kNegInf; }
+        static STCP_ALWAYS_INLINE double kernelLogValue(const double &log_value, const double &log_base_value)
+        {
+            return log1pExp(log_value) + log_base_value;
+        }
+        // e_n = exp(l_n) * (1 + e_{n-1}) is linear in e, so consecutive updates compose into
+        // e -> exp(log_slope) * e + exp(log_intercept), where log_slope is the sum of l_n
+        // and log_intercept is kernelLogValue applied from kNegInf.
+        static double composeLogValue(const double &log_value, const double &log_slope, const double &log_intercept)
+        {
+            const double log_scaled{log_value + log_slope};
+            if (log_scaled == kNegInf)
+            {
+                return log_intercept;
+            }
+            if (log_intercept == kNegInf)
+            {
+                return log_scaled;
+            }
+            return std::max(log_scaled, log_intercept) + log1pExp(-std::abs(log_scaled - log_intercept));
         }
     };
     template <typename L>
@@ -84,12 +117,26 @@ namespace stcp
         void updateLogValue(const double &x) override
         {
             this->m_log_value =
-                std::max(0.0, this->m_log_value) + this->m_base_obj.computeLogBaseValue(x);
+                kernelLogValue(this->m_log_value, this->m_base_obj.computeLogBaseValue(x));
         }
         void updateLogValueByAvg(const double &x_bar, const double &n) override
         {
             this->m_log_value =
-                std::max(0.0, this->m_log_value) + this->m_base_obj.computeLogBaseValueByAvg(x_bar, n);
+                kernelLogValue(this->m_log_value, this->m_base_obj.computeLogBaseValueByAvg(x_bar, n));
+        }
+
+        // Recursion shared with the contiguous arrays of MixBaselineE.
+        static double initialLogValue() { return kNegInf; }
+        static double kernelLogValue(const double &log_value, const double &log_base_value)
+        {
+            return std::max(0.0, log_value) + log_base_value;
+        }
+        // w_n = max(w_{n-1} + l_n, l_n) is affine in the max-plus algebra, so consecutive updates
+        // compose into w -> max(w + log_slope, log_intercept), where log_slope is the sum of l_n
+        // and log_intercept is kernelLogValue applied from kNegInf.
+        static double composeLogValue(const double &log_value, const double &log_slope, const double &log_intercept)
+        {
+            return std::max(log_value + log_slope, log_intercept);
         }
     };
 } // End of namespace stcp
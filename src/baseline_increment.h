@@ -2,6 +2,7 @@
 #define BASELINE_INCREMENT_H
 
 #include "stcp_interface.h"
+#include "fast_math.h"
 
 namespace stcp
 {
@@ -23,6 +24,8 @@ namespace stcp
         // Note batch update should take n as a double rather than integer for generality.
         virtual double computeLogBaseValueByAvg(const double &x_bar, const double &n) override = 0;
 
+        double getLambda() const { return m_lambda; }
+
     protected:
         double m_lambda{0};
     };
@@ -53,7 +56,44 @@ namespace stcp
         {
             return n * Normal::computeLogBaseValue(x_bar);
         }
-        
+
+        // Kernels for mixtures stored as contiguous arrays (see MixBaselineE).
+        // computeLogBaseValue(x) == lambda * transformInput(x) - getLogBaseOffset()
+        double getLogBaseOffset() const { return m_lambda_times_mu_plus_psi; }
+        double transformInput(const double &x) const { return x; }
+        // Parameters checked by snapshots (see checkpoint.h).
+        void hashParams(ConfigHash &hash) const
+        {
+            hash.add(m_lambda);
+            hash.add(m_mu);
+            hash.add(m_sig);
+        }
+        static double kernelLogBaseValue(const double &t,
+                                         const double &lambda,
+                                         const double &offset)
+        {
+            return lambda * t - offset;
+        }
+        static double kernelLogBaseValueByAvg(const double &x_bar,
+                                              const double &n,
+                                              const double &lambda,
+                                              const double &offset)
+        {
+            return n * (lambda * x_bar - offset);
+        }
+        // Linear kernels are exact for all inputs.
+        static bool isKernelInputInRange(const double &,
+                                         const double &,
+                                         const double &)
+        {
+            return true;
+        }
+        static double kernelLogBaseValueExact(const double &t,
+                                              const double &lambda,
+                                              const double &offset)
+        {
+            return kernelLogBaseValue(t, lambda, offset);
+        }
 
     protected:
         double m_mu{0.0};
@@ -118,6 +158,57 @@ namespace stcp
             return n * (m_lambda * x_bar + m_log_base_val_x_zero);
         }
 
+        // Kernels for mixtures stored as contiguous arrays (see MixBaselineE).
+        // Since log_base_val_x_one - log_base_val_x_zero == lambda,
+        // computeLogBaseValue(x) == lambda * transformInput(x) - getLogBaseOffset()
+        double getLogBaseOffset() const { return -m_log_base_val_x_zero; }
+        void hashParams(ConfigHash &hash) const
+        {
+            hash.add(m_lambda);
+            hash.add(m_p);
+        }
+        double transformInput(const double &x) const
+        {
+            if (std::abs(x) < kEps)
+            {
+                return 0.0;
+            }
+            else if (std::abs(x - 1.0) < kEps)
+            {
+                return 1.0;
+            }
+            else
+            {
+                throw std::runtime_error("Input must be either 0.0 or 1.0 or false or true.");
+            }
+        }
+        static double kernelLogBaseValue(const double &t,
+                                         const double &lambda,
+                                         const double &offset)
+        {
+            return lambda * t - offset;
+        }
+        static double kernelLogBaseValueByAvg(const double &x_bar,
+                                              const double &n,
+                                              const double &lambda,
+                                              const double &offset)
+        {
+            return n * (lambda * x_bar - offset);
+        }
+        // Linear kernels are exact for all inputs.
+        static bool isKernelInputInRange(const double &,
+                                         const double &,
+                                         const double &)
+        {
+            return true;
+        }
+        static double kernelLogBaseValueExact(const double &t,
+                                              const double &lambda,
+                                              const double &offset)
+        {
+            return kernelLogBaseValue(t, lambda, offset);
+        }
+
     protected:
         double m_p{0.5};
         double m_log_base_val_x_one{0.0};
@@ -172,6 +263,75 @@ namespace stcp
             throw std::runtime_error("computeLogBaseValueByAvg cannot be used for the Bounded case.");
         }
 
+        // Kernels for mixtures stored as contiguous arrays (see MixBaselineE).
+        // The ratio x / mu - 1 is shared by all components,
+        // so computeLogBaseValue(x) == log(1 + lambda * transformInput(x))
+        double getLogBaseOffset() const { return 0.0; }
+        void hashParams(ConfigHash &hash) const
+        {
+            hash.add(m_lambda);
+            hash.add(m_mu);
+        }
+        double transformInput(const double &x) const
+        {
+            if (x < 0.0)
+            {
+                throw std::runtime_error("Input must be non-negative.");
+            }
+            return x / m_mu - 1.0;
+        }
+        // Batch version of transformInput. All inputs are checked before any is transformed.
+        void checkInputs(const double *xs, const std::size_t &n) const
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                if (xs[i] < 0.0)
+                {
+                    throw std::runtime_error("Input must be non-negative.");
+                }
+            }
+        }
+        void transformCheckedInputs(const double *__restrict xs,
+                                    double *__restrict ts,
+                                    const std::size_t &n) const
+        {
+            const double mu{m_mu};
+            for (std::size_t i = 0; i < n; i++)
+            {
+                ts[i] = xs[i] / mu - 1.0;
+            }
+        }
+        // The vectorizable fastLog is used if 1 + lambda * t is a positive normal double
+        // for all lambdas, which holds for every x in [0, 1].
+        // Otherwise (e.g. NaN or large x with a negative lambda) the exact kernel is used.
+        static bool isKernelInputInRange(const double &t,
+                                         const double &lambda_min,
+                                         const double &lambda_max)
+        {
+            const double y_lo{1.0 + std::min(lambda_min * t, lambda_max * t)};
+            const double y_hi{1.0 + std::max(lambda_min * t, lambda_max * t)};
+            return y_lo >= kMinNormal && y_hi <= kMaxFinite;
+        }
+        static double kernelLogBaseValue(const double &t,
+                                         const double &lambda,
+                                         const double &)
+        {
+            return fastLog(1.0 + lambda * t);
+        }
+        static double kernelLogBaseValueExact(const double &t,
+                                              const double &lambda,
+                                              const double &)
+        {
+            return log(1.0 + lambda * t);
+        }
+        static double kernelLogBaseValueByAvg(const double &,
+                                              const double &,
+                                              const double &,
+                                              const double &)
+        {
+            throw std::runtime_error("computeLogBaseValueByAvg cannot be used for the Bounded case.");
+        }
+
     protected:
         double m_mu{0.5};
         void setupBounded(const double &lambda, const double &mu)
@@ -0,0 +1,198 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace stcp
+{
+    // Binary snapshots of detector states (see Stcp::saveState and ShardedStcpBank::saveState).
+    // A snapshot is a header of
+    //   magic (4 bytes), version (uint32), config hash (uint64), payload size (uint64)
+    // followed by the payload, all in the byte order of the host.
+    // Only the state is stored, i.e. time, stopped state, alarm times, per-component
+    // log values and GLR windows, so a snapshot is loaded into an object constructed with the same
+    // configuration, which is checked by the config hash.
+    constexpr std::uint32_t kSnapshotVersion{1};
+    constexpr char kSnapshotMagic[4]{'S', 'T', 'C', 'P'};
+    constexpr char kBankSnapshotMagic[4]{'S', 'T', 'C', 'B'};
+    constexpr std::size_t kSnapshotHeaderSize{4 + sizeof(std::uint32_t) + 2 * sizeof(std::uint64_t)};
+
+    // 64-bit FNV-1a hash of the configuration of a detector.
+    // Types are hashed by their mangled names, which are the same for GCC and Clang.
+    class ConfigHash
+    {
+    public:
+        void addBytes(const void *data, const std::size_t &size)
+        {
+            const unsigned char *bytes{static_cast<const unsigned char *>(data)};
+            for (std::size_t i = 0; i < size; i++)
+            {
+                m_hash ^= bytes[i];
+                m_hash *= kPrime;
+            }
+        }
+        template <typename T>
+        void add(const T &value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Type must be trivially copyable.");
+            addBytes(&value, sizeof(T));
+        }
+        template <typename T>
+        void add(const std::vector<T> &values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Type must be trivially copyable.");
+            add(static_cast<std::uint64_t>(values.size()));
+            addBytes(values.data(), values.size() * sizeof(T));
+        }
+        void addType(const std::type_info &type)
+        {
+            addBytes(type.name(), std::strlen(type.name()));
+        }
+
+        std::uint64_t get() const { return m_hash; }
+
+    private:
+        static constexpr std::uint64_t kPrime{1099511628211ULL};
+        std::uint64_t m_hash{14695981039346656037ULL};
+    };
+
+    // Appends values to a byte buffer.
+    class SnapshotWriter
+    {
+    public:
+        explicit SnapshotWriter(std::vector<unsigned char> &buffer)
+            : m_buffer{buffer}
+        {
+        }
+
+        void reserve(const std::size_t &size) { m_buffer.reserve(m_buffer.size() + size); }
+
+        // The payload size is filled in by finish().
+        void writeHeader(const char (&magic)[4], const std::uint64_t &config_hash)
+        {
+            m_header_pos = m_buffer.size();
+            writeArray(magic, 4);
+            write(kSnapshotVersion);
+            write(config_hash);
+            write(std::uint64_t{0});
+        }
+        void finish()
+        {
+            const std::uint64_t payload_size{m_buffer.size() - m_header_pos - kSnapshotHeaderSize};
+            std::memcpy(m_buffer.data() + m_header_pos + kSnapshotHeaderSize - sizeof(payload_size),
+                        &payload_size, sizeof(payload_size));
+        }
+
+        template <typename T>
+        void write(const T &value)
+        {
+            writeArray(&value, 1);
+        }
+        template <typename T>
+        void writeArray(const T *values, const std::size_t &n)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Type must be trivially copyable.");
+            const std::size_t pos{m_buffer.size()};
+            m_buffer.resize(pos + n * sizeof(T));
+            if (n > 0)
+            {
+                std::memcpy(m_buffer.data() + pos, values, n * sizeof(T));
+            }
+        }
+
+    private:
+        std::vector<unsigned char> &m_buffer;
+        std::size_t m_header_pos{0};
+    };
+
+    // Reads values written by SnapshotWriter with bounds checks.
+    class SnapshotReader
+    {
+    public:
+        SnapshotReader(const unsigned char *data, const std::size_t &size)
+            : m_data{data}, m_size{size}
+        {
+        }
+
+        // Check the header against the magic and the config hash of the object loading it.
+        void readHeader(const char (&magic)[4], const std::uint64_t &config_hash)
+        {
+            char snapshot_magic[4];
+            if (m_size < kSnapshotHeaderSize)
+            {
+                throw std::runtime_error("Snapshot is too short.");
+            }
+            readArray(snapshot_magic, 4);
+            if (std::memcmp(snapshot_magic, magic, 4) != 0)
+            {
+                throw std::runtime_error("Snapshot was not saved by an object of this class.");
+            }
+            if (read<std::uint32_t>() != kSnapshotVersion)
+            {
+                throw std::runtime_error("Snapshot version is not supported.");
+            }
+            if (read<std::uint64_t>() != config_hash)
+            {
+                throw std::runtime_error("Snapshot was saved by an object of a different configuration.");
+            }
+            if (read<std::uint64_t>() != m_size - m_pos)
+            {
+                throw std::runtime_error("Snapshot size does not match its header.");
+            }
+        }
+        std::size_t getRemainingSize() const { return m_size - m_pos; }
+        // The state loaded from the rest of a snapshot must take exactly size bytes,
+        // which objects check before changing their state.
+        void checkRemainingSize(const std::size_t &size) const
+        {
+            if (m_size - m_pos != size)
+            {
+                throw std::runtime_error("Snapshot size does not match the state of this object.");
+            }
+        }
+
+        template <typename T>
+        T read()
+        {
+            T value;
+            readArray(&value, 1);
+            return value;
+        }
+        template <typename T>
+        void readArray(T *values, const std::size_t &n)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Type must be trivially copyable.");
+            if (n > (m_size - m_pos) / sizeof(T))
+            {
+                throw std::runtime_error("Snapshot is truncated.");
+            }
+            if (n > 0)
+            {
+                std::memcpy(values, m_data + m_pos, n * sizeof(T));
+            }
+            m_pos += n * sizeof(T);
+        }
+        // Read a count written by the snapshot and check that it does not exceed max_count.
+        std::size_t readCount(const std::size_t &max_count)
+        {
+            const std::uint64_t count{read<std::uint64_t>()};
+            if (count > max_count)
+            {
+                throw std::runtime_error("Snapshot is corrupted.");
+            }
+            return static_cast<std::size_t>(count);
+        }
+
+    private:
+        const unsigned char *m_data;
+        std::size_t m_size;
+        std::size_t m_pos{0};
+    };
+} // End of namespace stcp
+#endif
@@ -0,0 +1,349 @@
+#ifndef COMPUTE_BASELINE_H
+#define COMPUTE_BASELINE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include "stcp_interface.h"
+
+namespace stcp
+{
+    // Root of f in [lower, upper] by Brent's method as in R's zeroin (used by stats::uniroot),
+    // so the roots agree with the R implementation of compute_baseline.
+    template <typename F>
+    inline double findRoot(const F &f, const double &lower, const double &upper, const double &tol, const int &max_iter = 1000)
+    {
+        double a{lower};
+        double b{upper};
+        double fa{f(a)};
+        double fb{f(b)};
+        if ((fa > 0.0 && fb > 0.0) || (fa < 0.0 && fb < 0.0))
+        {
+            throw std::runtime_error("Values of the root-finding function at the end points are not of opposite sign.");
+        }
+        if (fa == 0.0)
+        {
+            return a;
+        }
+        if (fb == 0.0)
+        {
+            return b;
+        }
+        double c{a};
+        double fc{fa};
+        for (int iter = 0; iter <= max_iter; iter++)
+        {
+            const double prev_step{b - a};
+            if (std::abs(fc) < std::abs(fb))
+            {
+                a = b;
+                b = c;
+                c = a;
+                fa = fb;
+                fb = fc;
+                fc = fa;
+            }
+            const double tol_act{2.0 * std::numeric_limits<double>::epsilon() * std::abs(b) + tol / 2.0};
+            double new_step{(c - b) / 2.0};
+            if (std::abs(new_step) <= tol_act || fb == 0.0)
+            {
+                return b;
+            }
+            // Interpolate if the previous step was large enough and in the right direction.
+            if (std::abs(prev_step) >= tol_act && std::abs(fa) > std::abs(fb))
+            {
+                const double cb{c - b};
+                double p;
+                double q;
+                if (a == c)
+                {
+                    // Linear interpolation
+                    const double t1{fb / fa};
+                    p = cb * t1;
+                    q = 1.0 - t1;
+                }
+                else
+                {
+                    // Inverse quadratic interpolation
+                    q = fa / fc;
+                    const double t1{fb / fc};
+                    const double t2{fb / fa};
+                    p = t2 * (cb * q * (q - t1) - (b - a) * (t1 - 1.0));
+                    q = (q - 1.0) * (t1 - 1.0) * (t2 - 1.0);
+                }
+                if (p > 0.0)
+                {
+                    q = -q;
+                }
+                else
+                {
+                    p = -p;
+                }
+                if (p < (0.75 * cb * q - std::abs(tol_act * q) / 2.0) && p < std::abs(prev_step * q / 2.0))
+                {
+                    new_step = p / q;
+                }
+            }
+            if (std::abs(new_step) < tol_act)
+            {
+                new_step = new_step > 0.0 ? tol_act : -tol_act;
+            }
+            a = b;
+            fa = fb;
+            b += new_step;
+            fb = f(b);
+            if ((fb > 0.0 && fc > 0.0) || (fb < 0.0 && fc < 0.0))
+            {
+                c = a;
+                fc = fa;
+            }
+        }
+        return b;
+    }
+
+    // psi_star functions of the pre-defined families in R/psi_fn.R.
+    class SubGPsi
+    {
+    public:
+        explicit SubGPsi(const double &sig = 1.0) : m_sig{sig} {}
+
+        double psiStar(const double &x) const { return x * x / 2.0 / (m_sig * m_sig); }
+        double psiStarDiv(const double &x) const { return x / (m_sig * m_sig); }
+        double psiStarInv(const double &y) const { return m_sig * std::sqrt(2.0 * y); }
+
+    private:
+        double m_sig;
+    };
+
+    class SubBPsi
+    {
+    public:
+        explicit SubBPsi(const double &p = 0.5) : m_p{p}
+        {
+            if (p <= 0.0 || p >= 1.0)
+            {
+                throw std::runtime_error("The sucess probability p must be strictly inbetween 0 and 1.");
+            }
+        }
+
+        double psiStar(const double &x) const
+        {
+            const double d{x + m_p};
+            if (d >= 1.0)
+            {
+                return log(1.0 / m_p);
+            }
+            if (d <= 0.0)
+            {
+                return log(1.0 / (1.0 - m_p));
+            }
+            return d * log(d / m_p) + (1.0 - d) * log((1.0 - d) / (1.0 - m_p));
+        }
+        double psiStarDiv(const double &x) const
+        {
+            const double d{x + m_p};
+            if (d >= 1.0)
+            {
+                return kPosInf;
+            }
+            if (d <= 0.0)
+            {
+                return kNegInf;
+            }
+            return log(d * (1.0 - m_p) / m_p / (1.0 - d));
+        }
+        double psiStarInv(const double &y) const
+        {
+            const double right_end{1.0 - m_p};
+            if (y >= psiStar(right_end))
+            {
+                return right_end;
+            }
+            return findRoot([this, &y](const double &x)
+                            { return psiStar(x) - y; },
+                            0.0, right_end, 1e-12);
+        }
+
+    private:
+        double m_p;
+    };
+
+    class SubEPsi
+    {
+    public:
+        double psiStar(const double &x) const { return x - log(1.0 + x); }
+        double psiStarDiv(const double &x) const { return x / (1.0 + x); }
+        double psiStarInv(const double &y) const
+        {
+            const double max_bound{1000.0};
+            if (psiStar(max_bound) - y <= 0.0)
+            {
+                return max_bound;
+            }
+            return findRoot([this, &y](const double &x)
+                            { return psiStar(x) - y; },
+                            0.0, max_bound, 1e-12);
+        }
+    };
+
+    // Output of compute_baseline without the psi functions.
+    struct BaselineParams
+    {
+        std::vector<double> lambdas;
+        std::vector<double> omegas;
+        double g_alpha;
+        int k_alpha;
+        double eta_alpha;
+        double w;
+    };
+
+    // Same as compute_baseline in R/compute_baseline.R for a family Psi with
+    // psiStar, psiStarDiv and psiStarInv. Inputs are checked on the R side.
+    template <typename Psi>
+    inline BaselineParams computeBaseline(const Psi &psi,
+                                          const double &alpha,
+                                          const double &delta_lower,
+                                          const double &delta_upper,
+                                          const double &v_min,
+                                          const int &k_max,
+                                          const double &tol)
+    {
+        const double log_one_over_alpha{log(1.0 / alpha)};
+        const double d_l{psi.psiStar(delta_lower)};
+        const double d_u{psi.psiStar(delta_upper)};
+        const double ratio{d_u / d_l};
+        const double lambda_l{psi.psiStarDiv(delta_lower)};
+        const double lambda_u{psi.psiStarDiv(delta_upper)};
+
+        // Trivial single baseline
+        if (log_one_over_alpha <= v_min * d_l || delta_lower == delta_upper)
+        {
+            return BaselineParams{{lambda_l}, {1.0}, log_one_over_alpha, 0, 1.0, alpha};
+        }
+
+        // ratio^(-1/k) is shared by every evaluation of log_f in the root-finding.
+        std::vector<double> ratio_pows(static_cast<std::size_t>(k_max));
+        for (int k = 1; k <= k_max; k++)
+        {
+            ratio_pows[k - 1] = std::pow(ratio, -1.0 / k);
+        }
+        // Minimum of log(k) - g * ratio^(-1/k) over k and its first minimizer.
+        const auto log_f_and_argmin = [&ratio_pows, &k_max](const double &g)
+        {
+            double min_val{kPosInf};
+            int argmin{1};
+            for (int k = 1; k <= k_max; k++)
+            {
+                const double val{log(static_cast<double>(k)) - g * ratio_pows[k - 1]};
+                if (val < min_val)
+                {
+                    min_val = val;
+                    argmin = k;
+                }
+            }
+            return std::make_pair(min_val, argmin);
+        };
+        const auto log_f = [&log_f_and_argmin](const double &g)
+        { return log_f_and_argmin(g).first; };
+
+        // Compute the threshold g_alpha
+        double g_alpha;
+        if (log_f(v_min * d_u) <= -log_one_over_alpha)
+        {
+            g_alpha = findRoot([&log_f, &log_one_over_alpha](const double &g)
+                               { return log_f(g) + log_one_over_alpha; },
+                               log_one_over_alpha, v_min * d_u, tol);
+        }
+        else
+        {
+            g_alpha = findRoot([&log_f, &log_one_over_alpha](const double &g)
+                               { return logSumExp(std::vector<double>{-g, log_f(g)}) + log_one_over_alpha; },
+                               v_min * d_u, ratio * log(2.0 / alpha), tol);
+        }
+
+        // Number of non-trivial baselines and their spacing
+        const int k_alpha{log_f_and_argmin(g_alpha).second};
+        const double eta_alpha{std::pow(ratio, 1.0 / k_alpha)};
+
+        // Lambdas from the largest to the smallest delta, with an extra baseline at
+        // lambda_u if g_alpha is above v_min * d_u.
+        const bool has_upper_baseline{g_alpha > v_min * d_u};
+        BaselineParams params{{}, {}, g_alpha, k_alpha, eta_alpha, 0.0};
+        params.lambdas.reserve(static_cast<std::size_t>(k_alpha) + 1);
+        if (has_upper_baseline)
+        {
+            params.lambdas.push_back(lambda_u);
+            params.omegas.push_back(exp(-g_alpha));
+        }
+        for (int k = 1; k < k_alpha; k++)
+        {
+            params.lambdas.push_back(psi.psiStarDiv(psi.psiStarInv(d_u / std::pow(eta_alpha, k))));
+        }
+        params.lambdas.push_back(lambda_l);
+        params.omegas.resize(params.lambdas.size(), exp(-g_alpha / eta_alpha));
+
+        // Normalize weights
+        for (auto &omega : params.omegas)
+        {
+            params.w += omega;
+        }
+        for (auto &omega : params.omegas)
+        {
+            omega /= params.w;
+        }
+        return params;
+    }
+
+    // computeBaseline of the family "sub-G" (family_param = sig), "sub-B" (family_param = p)
+    // or "sub-E" (family_param is ignored), memoized for the lifetime of the process.
+    // Detectors of the same configuration therefore solve for their baselines only once.
+    inline BaselineParams computeBaselineCached(const std::string &family_name,
+                                                const double &family_param,
+                                                const double &alpha,
+                                                const double &delta_lower,
+                                                const double &delta_upper,
+                                                const double &v_min,
+                                                const int &k_max,
+                                                const double &tol)
+    {
+        using Key = std::tuple<std::string, double, double, double, double, double, int, double>;
+        static std::map<Key, BaselineParams> cache;
+        static std::mutex cache_mutex;
+
+        const Key key{family_name, family_name == "sub-E" ? 0.0 : family_param,
+                      alpha, delta_lower, delta_upper, v_min, k_max, tol};
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            const auto it = cache.find(key);
+            if (it != cache.end())
+            {
+                return it->second;
+            }
+        }
+
+        BaselineParams params;
+        if (family_name == "sub-G")
+        {
+            params = computeBaseline(SubGPsi(family_param), alpha, delta_lower, delta_upper, v_min, k_max, tol);
+        }
+        else if (family_name == "sub-B")
+        {
+            params = computeBaseline(SubBPsi(family_param), alpha, delta_lower, delta_upper, v_min, k_max, tol);
+        }
+        else if (family_name == "sub-E")
+        {
+            params = computeBaseline(SubEPsi(), alpha, delta_lower, delta_upper, v_min, k_max, tol);
+        }
+        else
+        {
+            throw std::runtime_error("Unsupported family for the C++ baseline computation.");
+        }
+
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        cache.emplace(key, params);
+        return params;
+    }
+} // End of namespace stcp
+#endif
@@ -0,0 +1,190 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// Kernels are vectorized only if the functions they call are inlined into their loops,
+// which the -O2 inliner does not guarantee when a loop calls them several times.
+#if defined(__GNUC__) || defined(__clang__)
+#define STCP_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define STCP_ALWAYS_INLINE inline
+#endif
+
+namespace stcp
+{
+    // Smallest positive normal and largest finite doubles.
+    constexpr double kMinNormal{std::numeric_limits<double>::min()};
+    constexpr double kMaxFinite{std::numeric_limits<double>::max()};
+
+    STCP_ALWAYS_INLINE std::uint64_t doubleToBits(const double x)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+
+    STCP_ALWAYS_INLINE double bitsToDouble(const std::uint64_t bits)
+    {
+        double x;
+        std::memcpy(&x, &bits, sizeof(x));
+        return x;
+    }
+
+    // Number of set bits of a 64-bit word.
+    STCP_ALWAYS_INLINE int popcount64(const std::uint64_t bits)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(bits);
+#else
+        std::uint64_t x{bits - ((bits >> 1) & 0x5555555555555555ULL)};
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    // All ones if |x| < bound and zero otherwise (including NaN) for a positive bound.
+    // Non-negative doubles are ordered as their bits, and both bit patterns are below 2^63,
+    // so the sign of the difference is an exact comparison without floating-point branches.
+    STCP_ALWAYS_INLINE std::uint64_t absLessThanMask(const double x, const double bound)
+    {
+        const std::uint64_t abs_bits{doubleToBits(x) & 0x7fffffffffffffffULL};
+        return 0ULL - ((abs_bits - doubleToBits(bound)) >> 63);
+    }
+
+    // All ones if x is NaN and zero otherwise, by the same exact comparison of the bits of |x|
+    // with those of +Inf.
+    STCP_ALWAYS_INLINE std::uint64_t nanMask(const double x)
+    {
+        const std::uint64_t abs_bits{doubleToBits(x) & 0x7fffffffffffffffULL};
+        return 0ULL - ((0x7ff0000000000000ULL - abs_bits) >> 63);
+    }
+
+    // k * log(2) + log(1 + f) for f in [sqrt(2) / 2 - 1, sqrt(2) - 1] and an integer k,
+    // following the polynomial of fdlibm.
+    STCP_ALWAYS_INLINE double logReduced(const double f, const double k)
+    {
+        const double s{f / (2.0 + f)};
+        const double s2{s * s};
+        const double s4{s2 * s2};
+        const double t1{s4 * (3.999999999940941908e-01 +
+                              s4 * (2.222219843214978396e-01 +
+                                    s4 * 1.531383769920937332e-01))};
+        const double t2{s2 * (6.666666666666735130e-01 +
+                              s4 * (2.857142874366239149e-01 +
+                                    s4 * (1.818357216161805012e-01 +
+                                          s4 * 1.479819860511658591e-01)))};
+        const double hfsq{0.5 * f * f};
+        // log(2) split into high and low parts so that k * log(2) is exact in the high part.
+        return k * 6.93147180369123816490e-01 -
+               ((hfsq - (s * (hfsq + (t1 + t2)) + k * 1.90821492927058770002e-10)) - f);
+    }
+
+    // Natural log of a positive normal finite double, accurate to 1 ulp.
+    // y = 2^k * z with z in [sqrt(2) / 2, sqrt(2)) is split by integer operations only
+    // and log(z) follows the polynomial of fdlibm, so the function is branch-free and
+    // loops calling it can be vectorized (SSE2 / AVX2 / NEON).
+    // Zero, negative, subnormal, infinite and NaN inputs are NOT handled;
+    // callers must check the range and use std::log otherwise.
+    STCP_ALWAYS_INLINE double fastLog(const double y)
+    {
+        const std::uint64_t bits{doubleToBits(y)};
+        // k + 2048 where k = floor(log2(y / (sqrt(2) / 2))), computed without signed shifts.
+        const std::uint64_t k_biased{(bits - 0x3fe6a09e00000000ULL + 0x8000000000000000ULL) >> 52};
+        const double z{bitsToDouble(bits - (k_biased << 52) + 0x8000000000000000ULL)};
+        // Exact conversion of k to double through the mantissa of 2^52.
+        const double k{bitsToDouble(0x4330000000000000ULL | k_biased) - 4503599627372544.0}; // 2^52 + 2048
+
+        return logReduced(z - 1.0, k);
+    }
+
+    // Smallest input of fastExp. exp(kMinFastExpInput) is still a normal double.
+    constexpr double kMinFastExpInput{-708.0};
+
+    // exp(x) for x in [kMinFastExpInput, 709], accurate to 1 ulp.
+    // x = k * log(2) + r with |r| <= log(2) / 2 is split by the round-to-nearest shift
+    // 1.5 * 2^52, exp(r) is the Taylor polynomial of degree 13 (truncation below 2^-57)
+    // without any division, and 2^k is built from the exponent bits.
+    // Inputs outside the range are NOT handled; callers must clamp them.
+    STCP_ALWAYS_INLINE double fastExp(const double x)
+    {
+        const double shifted{x * 1.44269504088896338700e+00 + 6755399441055744.0};
+        const double k{shifted - 6755399441055744.0};
+        const double r{(x - k * 6.93147180369123816490e-01) - k * 1.90821492927058770002e-10};
+        // Estrin's scheme keeps the dependency chain short.
+        const double r2{r * r};
+        const double r4{r2 * r2};
+        const double r8{r4 * r4};
+        const double p23{0.5 + r * 1.6666666666666666e-01};
+        const double p45{4.1666666666666664e-02 + r * 8.3333333333333332e-03};
+        const double p67{1.3888888888888889e-03 + r * 1.9841269841269841e-04};
+        const double p89{2.4801587301587302e-05 + r * 2.7557319223985893e-06};
+        const double p1011{2.7557319223985888e-07 + r * 2.5052108385441720e-08};
+        const double p1213{2.0876756987868100e-09 + r * 1.6059043836821613e-10};
+        const double p{(p23 + r2 * p45) + r4 * (p67 + r2 * p89) +
+                       r8 * (p1011 + r2 * p1213)};
+        // The low bits of shifted hold k + 2^51, so 2^k is formed without conversion.
+        return (1.0 + (r + r2 * p)) * bitsToDouble((doubleToBits(shifted) - 0x4338000000000000ULL + 1023ULL) << 52);
+    }
+
+    // exp(x) for x <= 0 including -Inf. Results at or below exp(-708) are flushed to zero,
+    // and NaN is returned as is. Clamping and flushing use bit masks only,
+    // so loops calling it can be vectorized.
+    STCP_ALWAYS_INLINE double fastExpNonPositive(const double x)
+    {
+        const std::uint64_t in_range{absLessThanMask(x, -kMinFastExpInput)};
+        const double x_clamped{bitsToDouble((doubleToBits(x) & in_range) |
+                                            (doubleToBits(kMinFastExpInput) & ~in_range))};
+        return bitsToDouble((doubleToBits(fastExp(x_clamped)) & in_range) |
+                            (doubleToBits(x) & nanMask(x)));
+    }
+
+    // log(1 + exp(x)) for any x including +-Inf, accurate to 2 ulp.
+    // It is computed as max(x, 0) + log1p(exp(-|x|)), so the exponential never overflows
+    // and for x > 37 the second term is below half an ulp of x and the result is x.
+    // Results at or below exp(-708) are flushed to zero, so log1pExp(-Inf) == 0,
+    // and log1pExp(NaN) is NaN.
+    STCP_ALWAYS_INLINE double log1pExp(const double x)
+    {
+        const std::uint64_t bits{doubleToBits(x)};
+        const double u{fastExpNonPositive(bitsToDouble(bits | 0x8000000000000000ULL))};
+        // log1p(u) for u in [0, 1] is reduced as in fastLog without rounding 1 + u:
+        // k = 0 and f = u below sqrt(2) - 1, and k = 1 and f = (u - 1) / 2 otherwise.
+        const std::uint64_t is_small{absLessThanMask(u, 4.14213562373095145475e-01)};
+        const double f{bitsToDouble((doubleToBits(u) & is_small) |
+                                    (doubleToBits(0.5 * (u - 1.0)) & ~is_small))};
+        const double k{bitsToDouble(doubleToBits(1.0) & ~is_small)};
+        // max(x, 0) by clearing x if its sign bit is set.
+        const double x_pos{bitsToDouble(bits & ((bits >> 63) - 1ULL))};
+        return x_pos + logReduced(f, k);
+    }
+
+    // sum_i exp(xs[i] - max_x) for max_x >= xs[i], in blocks of kBlockSize partial sums
+    // so that the loop is vectorized. Terms at or below exp(-708), including exp(-Inf), are
+    // flushed to zero; they are below the rounding error of the sum which is at least 1.
+    // NaN terms make the sum NaN.
+    inline double sumExpCentered(const double *xs, const std::size_t &n, const double &max_x)
+    {
+        constexpr std::size_t kBlockSize{4};
+        double block_sum[kBlockSize]{0.0, 0.0, 0.0, 0.0};
+        std::size_t i{0};
+        for (; i + kBlockSize <= n; i += kBlockSize)
+        {
+            for (std::size_t j = 0; j < kBlockSize; j++)
+            {
+                block_sum[j] += fastExpNonPositive(xs[i + j] - max_x);
+            }
+        }
+        double sum_exp{(block_sum[0] + block_sum[1]) + (block_sum[2] + block_sum[3])};
+        for (; i < n; i++)
+        {
+            sum_exp += fastExpNonPositive(xs[i] - max_x);
+        }
+        return sum_exp;
+    }
+} // End of namespace stcp
+#endif
@@ -0,0 +1,294 @@
+#ifndef GLRCU_APPROX_E_H
+#define GLRCU_APPROX_E_H
+
+#include "stcp_interface.h"
+#include "log_lr_increment.h"
+#include "log_lr_e.h"
+
+namespace stcp
+{
+    // Approximate GLR-CUSUM over a geometric grid of candidate change points.
+    // The last window_size observations are summarized by an exponential histogram:
+    // buckets of sizes 1, 2, 4, ... with at most max_buckets_per_size buckets of each size,
+    // where the two oldest buckets of a size are merged when the limit is exceeded.
+    // Candidate change points are the starts of the buckets, so both the memory and
+    // the cost per observation are O(max_buckets_per_size * log(window_size)).
+    //
+    // Error bound:
+    // Every grid window is also a window of the exact GLRCU, so the approximate
+    // log value is never larger than the exact one.
+    // getLogValueUpperBound() returns a certified upper bound of the exact log value.
+    // It bounds the LLR of all windows starting inside each bucket, using the smallest
+    // and largest partial sums of the bucket and the convexity of n * g(S / n).
+    // Hence approx <= exact GLRCU <= upper bound at every time, and
+    //   0 <= exact GLRCU - getLogValue() <= getLogValueUpperBound() - getLogValue()
+    // is the certified under-estimation, which can be checked online.
+    // Sizes below the largest one always keep at least max_buckets_per_size - 1 buckets,
+    // so a bucket of size c has at least (max_buckets_per_size - 1) * (c - 1) newer
+    // observations. An exact window starting inside it thus differs from the grid window
+    // starting at its newer end by c - 1 <= n / (max_buckets_per_size - 1) observations,
+    // where n is the length of the grid window, and the gap shrinks as
+    // max_buckets_per_size grows.
+    template <typename L>
+    class GLRCUApprox : public LogLRE<L>
+    {
+    public:
+        GLRCUApprox()
+            : GLRCUApprox<L>::GLRCUApprox(L(), 100, 4)
+        {
+        }
+        GLRCUApprox(const L &base_obj, const int &window_size)
+            : GLRCUApprox<L>::GLRCUApprox(base_obj, window_size, 4)
+        {
+        }
+        GLRCUApprox(const L &base_obj, const int &window_size, const int &max_buckets_per_size);
+
+        void reset() override;
+        void updateLogValue(const double &x) override;
+
+        double getLogValueUpperBound();
+        std::size_t getNumBuckets() { return m_buckets.size(); }
+
+        // Snapshots of the state (see Stcp::saveState). The log value and the buckets
+        // are stored, and loadState reads them from the rest of the snapshot.
+        void hashConfig(ConfigHash &hash) const
+        {
+            hash.addType(typeid(GLRCUApprox<L>));
+            this->m_base_obj.hashParams(hash);
+            hash.add(m_window_size);
+            hash.add(static_cast<std::uint64_t>(m_max_buckets_per_size));
+        }
+        void saveState(SnapshotWriter &writer) const;
+        void loadState(SnapshotReader &reader);
+
+    private:
+        struct Bucket
+        {
+            double sum;
+            double count;
+            // Smallest and largest sums of the last j observations in the bucket
+            // over j = 1, ..., count.
+            double min_partial_sum;
+            double max_partial_sum;
+        };
+        // Buckets from the oldest to the newest.
+        std::vector<Bucket> m_buckets;
+        double m_window_size{100.0};
+        std::size_t m_max_buckets_per_size{4};
+        double m_total_count{0.0};
+
+        // One more bucket per size than the limit may exist before the merge.
+        std::size_t getMaxNumBuckets() const
+        {
+            const std::size_t num_sizes{static_cast<std::size_t>(std::log2(m_window_size)) + 2};
+            return (m_max_buckets_per_size + 1) * num_sizes;
+        }
+        void mergeBuckets();
+        double computeMaxLLRUpperBound(const double &sum_lo,
+                                       const double &sum_hi,
+                                       const double &n_lo,
+                                       const double &n_hi) const;
+    };
+
+    // Constructors
+    template <typename L>
+    inline GLRCUApprox<L>::GLRCUApprox(const L &base_obj,
+                                       const int &window_size,
+                                       const int &max_buckets_per_size)
+        : LogLRE<L>::LogLRE(base_obj),
+          m_window_size{static_cast<double>(window_size)},
+          m_max_buckets_per_size{static_cast<std::size_t>(std::max(max_buckets_per_size, 0))}
+    {
+        if (window_size <= 0)
+        {
+            throw std::runtime_error("Window size must be strictly positive.");
+        }
+        if (max_buckets_per_size < 2)
+        {
+            throw std::runtime_error("Maximum number of buckets per size must be larger than 1.");
+        }
+        m_buckets.reserve(getMaxNumBuckets());
+    }
+
+    // Public members
+    template <typename L>
+    inline void GLRCUApprox<L>::reset()
+    {
+        this->m_log_value = kNegInf;
+        m_buckets.clear();
+        m_total_count = 0.0;
+    }
+
+    template <typename L>
+    inline void GLRCUApprox<L>::updateLogValue(const double &x)
+    {
+        m_buckets.push_back(Bucket{x, 1.0, x, x});
+        m_total_count += 1.0;
+        mergeBuckets();
+        // Drop the oldest bucket if the remaining ones still cover the window.
+        while (m_total_count - m_buckets.front().count >= m_window_size)
+        {
+            m_total_count -= m_buckets.front().count;
+            m_buckets.erase(m_buckets.begin());
+        }
+
+        // Windows starting at the bucket starts.
+        double sum{0.0};
+        double count{0.0};
+        double max_log_value{kNegInf};
+        for (auto it = m_buckets.rbegin(); it != m_buckets.rend(); it++)
+        {
+            sum += it->sum;
+            count += it->count;
+            if (count > m_window_size)
+            {
+                break;
+            }
+            max_log_value = std::max(max_log_value,
+                                     this->m_base_obj.L::computeMaxLLRBySum(sum, count));
+        }
+        this->m_log_value = max_log_value;
+    }
+
+    template <typename L>
+    inline void GLRCUApprox<L>::saveState(SnapshotWriter &writer) const
+    {
+        writer.write(this->m_log_value);
+        writer.write(m_total_count);
+        writer.write(static_cast<std::uint64_t>(m_buckets.size()));
+        writer.writeArray(m_buckets.data(), m_buckets.size());
+    }
+    template <typename L>
+    inline void GLRCUApprox<L>::loadState(SnapshotReader &reader)
+    {
+        const double log_value{reader.read<double>()};
+        const double total_count{reader.read<double>()};
+        const std::size_t num_buckets{reader.readCount(getMaxNumBuckets())};
+        reader.checkRemainingSize(num_buckets * sizeof(Bucket));
+        std::vector<Bucket> buckets(num_buckets);
+        reader.readArray(buckets.data(), num_buckets);
+        // mergeBuckets relies on sizes being powers of two, non-increasing from the oldest
+        // to the newest bucket, with at most m_max_buckets_per_size buckets of each size,
+        // so they are checked before the state is changed.
+        double count_sum{0.0};
+        std::size_t num_same_size{0};
+        for (std::size_t i = 0; i < num_buckets; i++)
+        {
+            const Bucket &bucket{buckets[i]};
+            int exponent;
+            const bool is_power_of_two{bucket.count >= 1.0 && std::frexp(bucket.count, &exponent) == 0.5};
+            num_same_size = i > 0 && bucket.count == buckets[i - 1].count ? num_same_size + 1 : 1;
+            if (!is_power_of_two ||
+                (i > 0 && bucket.count > buckets[i - 1].count) ||
+                num_same_size > m_max_buckets_per_size ||
+                !std::isfinite(bucket.sum) ||
+                !(bucket.min_partial_sum <= bucket.max_partial_sum) ||
+                !std::isfinite(bucket.min_partial_sum) ||
+                !std::isfinite(bucket.max_partial_sum))
+            {
+                throw std::runtime_error("Snapshot is corrupted.");
+            }
+            count_sum += bucket.count;
+        }
+        if (total_count != count_sum)
+        {
+            throw std::runtime_error("Snapshot is corrupted.");
+        }
+        m_buckets.assign(buckets.begin(), buckets.end());
+        this->m_log_value = log_value;
+        m_total_count = total_count;
+    }
+
+    template <typename L>
+    inline double GLRCUApprox<L>::getLogValueUpperBound()
+    {
+        // Windows starting inside each bucket.
+        double sum{0.0};
+        double count{0.0};
+        double max_log_value{kNegInf};
+        for (auto it = m_buckets.rbegin(); it != m_buckets.rend(); it++)
+        {
+            if (count + 1.0 > m_window_size)
+            {
+                break;
+            }
+            max_log_value = std::max(max_log_value,
+                                     computeMaxLLRUpperBound(sum + it->min_partial_sum,
+                                                             sum + it->max_partial_sum,
+                                                             count + 1.0,
+                                                             std::min(count + it->count, m_window_size)));
+            sum += it->sum;
+            count += it->count;
+        }
+        return max_log_value;
+    }
+
+    // Private members
+    template <typename L>
+    inline void GLRCUApprox<L>::mergeBuckets()
+    {
+        // Sizes are non-increasing from the oldest to the newest bucket,
+        // so buckets of the same size are adjacent.
+        std::size_t last{m_buckets.size() - 1};
+        double size{1.0};
+        while (true)
+        {
+            std::size_t first{last};
+            while (first > 0 && m_buckets[first - 1].count == size)
+            {
+                first--;
+            }
+            if (last - first + 1 <= m_max_buckets_per_size)
+            {
+                break;
+            }
+            // Merge the two oldest buckets of the size.
+            Bucket &older{m_buckets[first]};
+            const Bucket &newer{m_buckets[first + 1]};
+            older.min_partial_sum = std::min(newer.min_partial_sum, newer.sum + older.min_partial_sum);
+            older.max_partial_sum = std::max(newer.max_partial_sum, newer.sum + older.max_partial_sum);
+            older.sum += newer.sum;
+            older.count += newer.count;
+            m_buckets.erase(m_buckets.begin() + first + 1);
+
+            last = first;
+            size *= 2.0;
+        }
+    }
+
+    template <typename L>
+    inline double GLRCUApprox<L>::computeMaxLLRUpperBound(const double &sum_lo,
+                                                          const double &sum_hi,
+                                                          const double &n_lo,
+                                                          const double &n_hi) const
+    {
+        // The max LLR f(S, n) = n * g(S / n) is jointly convex in (S, n)
+        // as the perspective of a convex g, so its maximum over the box
+        // [sum_lo, sum_hi] x [n_lo, n_hi] is attained at one of the corners.
+        const L &lr_obj{this->m_base_obj};
+        if (!std::is_base_of<BerLR, L>::value)
+        {
+            return std::max(std::max(lr_obj.L::computeMaxLLRBySum(sum_lo, n_lo),
+                                     lr_obj.L::computeMaxLLRBySum(sum_lo, n_hi)),
+                            std::max(lr_obj.L::computeMaxLLRBySum(sum_hi, n_lo),
+                                     lr_obj.L::computeMaxLLRBySum(sum_hi, n_hi)));
+        }
+        // For binary observations, the domain is 0 <= S <= n, so the vertices of
+        // the box cut by S = n are also checked. Clamped corners are either vertices
+        // or points in the domain, which can only loosen the bound.
+        double max_value{std::max(std::max(lr_obj.L::computeMaxLLRBySum(std::min(sum_lo, n_lo), n_lo),
+                                           lr_obj.L::computeMaxLLRBySum(std::min(sum_lo, n_hi), n_hi)),
+                                  std::max(lr_obj.L::computeMaxLLRBySum(std::min(sum_hi, n_lo), n_lo),
+                                           lr_obj.L::computeMaxLLRBySum(std::min(sum_hi, n_hi), n_hi)))};
+        for (const double &t : {sum_lo, sum_hi})
+        {
+            if (t >= n_lo && t <= n_hi)
+            {
+                max_value = std::max(max_value, lr_obj.L::computeMaxLLRBySum(t, t));
+            }
+        }
+        return max_value;
+    }
+
+} // End of namespace stcp
+#endif
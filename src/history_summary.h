@@ -0,0 +1,140 @@
+#ifndef HISTORY_SUMMARY_H
+#define HISTORY_SUMMARY_H
+
+#include "stcp_interface.h"
+
+namespace stcp
+{
+    // Log values passed at once from Stcp::updateAndSummarizeHistoriesBySpan to a summary.
+    constexpr std::size_t kHistoryChunkSize{1 << 12};
+
+    // Summaries of the history of log values of a long series, which take the log values
+    // chunk by chunk by add(log_values, len) and keep only their result, so the log value
+    // of every observation is never stored. Observations are indexed from 1 in the order
+    // of the series.
+
+    // Every k-th log value, i.e. the log values of the observations k, 2k, ...
+    class DecimatedHistory
+    {
+    public:
+        explicit DecimatedHistory(const std::size_t &k)
+            : m_k{k}
+        {
+            if (k == 0)
+            {
+                throw std::runtime_error("k must be a positive integer.");
+            }
+        }
+
+        void add(const double *log_values, const std::size_t &len)
+        {
+            // Position in this chunk of the next k-th log value.
+            std::size_t i{m_k - 1 - m_count % m_k};
+            for (; i < len; i += m_k)
+            {
+                m_log_values.push_back(log_values[i]);
+            }
+            m_count += len;
+        }
+
+        std::size_t getNumObservations() const { return m_count; }
+        const std::vector<double> &getLogValues() const { return m_log_values; }
+
+    private:
+        std::size_t m_k;
+        std::size_t m_count{0};
+        std::vector<double> m_log_values;
+    };
+
+    // Minimum, maximum and last log values of each bucket of bucket_size consecutive observations.
+    // The last bucket is partial if the number of observations is not a multiple of bucket_size.
+    class HistoryEnvelope
+    {
+    public:
+        explicit HistoryEnvelope(const std::size_t &bucket_size)
+            : m_bucket_size{bucket_size}
+        {
+            if (bucket_size == 0)
+            {
+                throw std::runtime_error("bucket_size must be a positive integer.");
+            }
+        }
+
+        void add(const double *log_values, const std::size_t &len)
+        {
+            std::size_t i{0};
+            while (i < len)
+            {
+                if (m_count % m_bucket_size == 0)
+                {
+                    m_mins.push_back(kPosInf);
+                    m_maxs.push_back(kNegInf);
+                    m_lasts.push_back(0.0);
+                }
+                const std::size_t end{std::min(len, i + m_bucket_size - m_count % m_bucket_size)};
+                double min_value{m_mins.back()};
+                double max_value{m_maxs.back()};
+                for (std::size_t j = i; j < end; j++)
+                {
+                    min_value = std::min(min_value, log_values[j]);
+                    max_value = std::max(max_value, log_values[j]);
+                }
+                m_mins.back() = min_value;
+                m_maxs.back() = max_value;
+                m_lasts.back() = log_values[end - 1];
+                m_count += end - i;
+                i = end;
+            }
+        }
+
+        std::size_t getNumObservations() const { return m_count; }
+        const std::vector<double> &getMins() const { return m_mins; }
+        const std::vector<double> &getMaxs() const { return m_maxs; }
+        const std::vector<double> &getLasts() const { return m_lasts; }
+
+    private:
+        std::size_t m_bucket_size;
+        std::size_t m_count{0};
+        std::vector<double> m_mins;
+        std::vector<double> m_maxs;
+        std::vector<double> m_lasts;
+    };
+
+    // Log values not less than lower, e.g. threshold - margin, and the indices of their observations.
+    class NearThresholdHistory
+    {
+    public:
+        explicit NearThresholdHistory(const double &lower)
+            : m_lower{lower}
+        {
+            if (std::isnan(lower))
+            {
+                throw std::runtime_error("Lower bound of log values must not be NaN.");
+            }
+        }
+
+        void add(const double *log_values, const std::size_t &len)
+        {
+            for (std::size_t i = 0; i < len; i++)
+            {
+                if (log_values[i] >= m_lower)
+                {
+                    m_indices.push_back(static_cast<double>(m_count + i + 1));
+                    m_log_values.push_back(log_values[i]);
+                }
+            }
+            m_count += len;
+        }
+
+        std::size_t getNumObservations() const { return m_count; }
+        const std::vector<double> &getIndices() const { return m_indices; }
+        const std::vector<double> &getLogValues() const { return m_log_values; }
+
+    private:
+        double m_lower;
+        std::size_t m_count{0};
+        std::vector<double> m_indices;
+        std::vector<double> m_log_values;
+    };
+} // End of namespace stcp
+#endif
@@ -1,7 +1,10 @@
 #ifndef LOG_LR_E_H
 #define LOG_LR_E_H
 
+#include <memory>
+
 #include "stcp_interface.h"
+#include "log_lr_increment.h"
 
 namespace stcp
 {
@@ -24,6 +27,7 @@ namespace stcp
         }
 
         double getLogValue() override { return m_log_value; }
+        bool isLogValueAbove(const double &log_threshold) override { return m_log_value > log_threshold; }
         void reset() override { m_log_value = kNegInf; }
         virtual void updateLogValue(const double &x) override = 0;
         void updateLogValueByAvg(const double &x_bar, const double &n) override
@@ -36,55 +40,472 @@ namespace stcp
         L m_base_obj;
     };
 
+    // GLR-CUSUM over the most recent window_size change points.
+    // For each candidate change point, the sum and the number of observations
+    // since then are kept in a fixed-capacity ring buffer.
+    // Every update adds x to all windows and maximizes the LLR over them
+    // in kernels that call the non-virtual computeMaxLLRBySum of L,
+    // so there are neither allocations nor virtual calls per observation.
+    //
+    // A batch (x_bar, n) is a single candidate change point, so the cost of
+    // updateLogValueByAvg does not depend on n. By default the window holds the
+    // last window_size batches. If is_window_in_samples is true, windows covering
+    // more than window_size samples are dropped as well, but the newest batch is always kept.
     template <typename L>
     class GLRCU : public LogLRE<L>
     {
     public:
-        using LogLRE<L>::LogLRE;
         GLRCU()
-            : LogLRE<L>::LogLRE()
+            : GLRCU<L>::GLRCU(L(), 100)
+        {
+        }
+        GLRCU(const L &base_obj)
+            : GLRCU<L>::GLRCU(base_obj, 100)
         {
         }
         GLRCU(const int &window_size)
-            : LogLRE<L>::LogLRE(), m_window_size{window_size}
+            : GLRCU<L>::GLRCU(L(), window_size)
         {
         }
         GLRCU(const L &base_obj, const int &window_size)
-            : LogLRE<L>::LogLRE(base_obj), m_window_size{window_size}
+            : GLRCU<L>::GLRCU(base_obj, window_size, false)
+        {
+        }
+        GLRCU(const L &base_obj, const int &window_size, const bool &is_window_in_samples)
+            : LogLRE<L>::LogLRE(base_obj),
+              m_window_size{static_cast<double>(window_size)},
+              m_is_window_in_samples{is_window_in_samples}
         {
+            if (window_size <= 0)
+            {
+                throw std::runtime_error("Window size must be strictly positive.");
+            }
+            m_window_sums.resize(window_size);
+            m_window_counts.resize(window_size);
         }
-        void reset() override 
-        { 
-            this->m_log_value = kNegInf; 
-            m_h1_mle_history.clear();
+        void reset() override
+        {
+            this->m_log_value = kNegInf;
+            m_num_windows = 0;
+            m_oldest_pos = 0;
         }
         void updateLogValue(const double &x) override
         {
-            if (static_cast<int>(m_h1_mle_history.size()) >= m_window_size)
+            updateWindows(x, 1.0);
+        }
+        void updateLogValueByAvg(const double &x_bar, const double &n) override
+        {
+            if (n <= 0.0)
+            {
+                throw std::runtime_error("Sample size must be strictly positive.");
+            }
+            updateWindows(n * x_bar, n);
+        }
+
+        // Snapshots of the state (see Stcp::saveState). The log value and the windows
+        // from the oldest to the newest are stored, and loadState reads them
+        // from the rest of the snapshot.
+        void hashConfig(ConfigHash &hash) const
+        {
+            hash.addType(typeid(GLRCU<L>));
+            this->m_base_obj.hashParams(hash);
+            hash.add(m_window_size);
+            hash.add(m_is_window_in_samples);
+        }
+        void saveState(SnapshotWriter &writer) const;
+        void loadState(SnapshotReader &reader);
+
+    private:
+        std::vector<double> m_window_sums;
+        std::vector<double> m_window_counts;
+        double m_window_size{100.0};
+        bool m_is_window_in_samples{false};
+        std::size_t m_num_windows{0};
+        std::size_t m_oldest_pos{0};
+
+        void updateWindows(const double &sum, const double &n);
+        static double updateWindowsKernel(const L &base_obj,
+                                          double *__restrict sums,
+                                          double *__restrict counts,
+                                          const double x,
+                                          const double n,
+                                          const std::size_t k);
+    };
+
+    // Public members
+    template <typename L>
+    inline void GLRCU<L>::saveState(SnapshotWriter &writer) const
+    {
+        const std::size_t first_len{std::min(m_num_windows, m_window_sums.size() - m_oldest_pos)};
+        writer.write(this->m_log_value);
+        writer.write(static_cast<std::uint64_t>(m_num_windows));
+        writer.writeArray(m_window_sums.data() + m_oldest_pos, first_len);
+        writer.writeArray(m_window_sums.data(), m_num_windows - first_len);
+        writer.writeArray(m_window_counts.data() + m_oldest_pos, first_len);
+        writer.writeArray(m_window_counts.data(), m_num_windows - first_len);
+    }
+    template <typename L>
+    inline void GLRCU<L>::loadState(SnapshotReader &reader)
+    {
+        const double log_value{reader.read<double>()};
+        const std::size_t num_windows{reader.readCount(m_window_sums.size())};
+        reader.checkRemainingSize(2 * num_windows * sizeof(double));
+        std::vector<double> sums(num_windows);
+        std::vector<double> counts(num_windows);
+        reader.readArray(sums.data(), num_windows);
+        reader.readArray(counts.data(), num_windows);
+        // Windows with non-positive counts give NaN LLRs, and counts are largest for
+        // the oldest windows, so they are checked before the state is changed.
+        for (std::size_t i = 0; i < num_windows; i++)
+        {
+            if (!std::isfinite(sums[i]) || !std::isfinite(counts[i]) || !(counts[i] > 0.0) ||
+                (i > 0 && counts[i] > counts[i - 1]))
+            {
+                throw std::runtime_error("Snapshot is corrupted.");
+            }
+        }
+        std::copy(sums.begin(), sums.end(), m_window_sums.begin());
+        std::copy(counts.begin(), counts.end(), m_window_counts.begin());
+        this->m_log_value = log_value;
+        m_num_windows = num_windows;
+        m_oldest_pos = 0;
+    }
+
+    // Private members
+    template <typename L>
+    inline void GLRCU<L>::updateWindows(const double &sum, const double &n)
+    {
+        const std::size_t capacity{m_window_sums.size()};
+        if (m_is_window_in_samples)
+        {
+            // Counts are largest for the oldest windows.
+            while (m_num_windows > 0 && m_window_counts[m_oldest_pos] + n > m_window_size)
             {
-                m_h1_mle_history.pop_back();
+                m_oldest_pos = (m_oldest_pos + 1) % capacity;
+                m_num_windows--;
             }
+        }
+        // Open a new window starting from the batch, overwriting the oldest one if full.
+        if (m_num_windows == capacity)
+        {
+            m_oldest_pos = (m_oldest_pos + 1) % capacity;
+            m_num_windows--;
+        }
+        const std::size_t new_pos{(m_oldest_pos + m_num_windows) % capacity};
+        m_window_sums[new_pos] = 0.0;
+        m_window_counts[new_pos] = 0.0;
+        m_num_windows++;
 
-            m_h1_mle_history.push_front(0.0);
-            int n{0};
-            double max_log_value{kNegInf};
-            for (auto &h_1_mle : m_h1_mle_history)
+        // Windows are stored in at most two contiguous segments of the ring and
+        // the maximum does not depend on their order.
+        const std::size_t first_len{std::min(m_num_windows, capacity - m_oldest_pos)};
+        double max_log_value{updateWindowsKernel(this->m_base_obj,
+                                                 m_window_sums.data() + m_oldest_pos,
+                                                 m_window_counts.data() + m_oldest_pos,
+                                                 sum,
+                                                 n,
+                                                 first_len)};
+        if (first_len < m_num_windows)
+        {
+            max_log_value = std::max(max_log_value,
+                                     updateWindowsKernel(this->m_base_obj,
+                                                         m_window_sums.data(),
+                                                         m_window_counts.data(),
+                                                         sum,
+                                                         n,
+                                                         m_num_windows - first_len));
+        }
+        this->m_log_value = max_log_value;
+    }
+
+    // The kernel follows the block pattern of MixBaselineE so that
+    // the compiler can vectorize it at -O2.
+    // Adding the batch and maximizing the LLR are fused into a single pass over the windows.
+    template <typename L>
+    inline double GLRCU<L>::updateWindowsKernel(const L &base_obj,
+                                                double *__restrict sums,
+                                                double *__restrict counts,
+                                                const double x,
+                                                const double n,
+                                                const std::size_t k)
+    {
+        // Local copy of the parameters so that they are kept in registers.
+        const L lr_obj{base_obj};
+        double block_max[kSimdBlockSize];
+        std::fill(block_max, block_max + kSimdBlockSize, kNegInf);
+        std::size_t i{0};
+        for (; i + kSimdBlockSize <= k; i += kSimdBlockSize)
+        {
+            for (std::size_t j = 0; j < kSimdBlockSize; j++)
             {
-                n++; // n: sample size *after" taking account for new observation x
-                this->m_base_obj.updateH1MLE(h_1_mle, x, n);
-                double log_value_new{this->m_base_obj.computeMaxLLR(h_1_mle, n)};
-                if (max_log_value < log_value_new)
-                {
-                    max_log_value = log_value_new;
-                }
+                sums[i + j] += x;
+                counts[i + j] += n;
+                block_max[j] = std::max(block_max[j],
+                                        lr_obj.L::computeMaxLLRBySum(sums[i + j], counts[i + j]));
             }
-            this->m_log_value = max_log_value;
         }
+        double max_log_value{*std::max_element(block_max, block_max + kSimdBlockSize)};
+        for (; i < k; i++)
+        {
+            sums[i] += x;
+            counts[i] += n;
+            max_log_value = std::max(max_log_value,
+                                     lr_obj.L::computeMaxLLRBySum(sums[i], counts[i]));
+        }
+        return max_log_value;
+    }
+
+    // GLR-CUSUM for binary observations.
+    // Within a window of n binary observations the MLE is always k / n with an integer k,
+    // so n * KL(k / n || p) under the H1 restriction of L is tabulated for all 0 <= k <= n
+    // up to n = min(window_size, kMaxLLRTableWindowSize) at construction.
+    // Windows keep integer success counts and the update is a table lookup per window.
+    // Longer windows fall back to computeMaxLLRBySum.
+    // The table is shared by copies of the object.
+    // Batches (x_bar, n) must have an integer n and an integer number of successes n * x_bar,
+    // and open a single window each as in GLRCU.
+    template <typename L>
+    class GLRCUBinary : public LogLRE<L>
+    {
+        static_assert(
+            std::is_base_of<BerLR, L>::value,
+            "Type must be derived from BerLR class.");
+
+    public:
+        GLRCUBinary()
+            : GLRCUBinary<L>::GLRCUBinary(L(), 100)
+        {
+        }
+        GLRCUBinary(const L &base_obj)
+            : GLRCUBinary<L>::GLRCUBinary(base_obj, 100)
+        {
+        }
+        GLRCUBinary(const int &window_size)
+            : GLRCUBinary<L>::GLRCUBinary(L(), window_size)
+        {
+        }
+        GLRCUBinary(const L &base_obj, const int &window_size)
+            : GLRCUBinary<L>::GLRCUBinary(base_obj, window_size, false)
+        {
+        }
+        GLRCUBinary(const L &base_obj, const int &window_size, const bool &is_window_in_samples);
+
+        void reset() override
+        {
+            this->m_log_value = kNegInf;
+            m_num_windows = 0;
+            m_oldest_pos = 0;
+        }
+        void updateLogValue(const double &x) override;
+        void updateLogValueByAvg(const double &x_bar, const double &n) override;
+
+        // Snapshots of the state as in GLRCU. The table is computed at construction.
+        void hashConfig(ConfigHash &hash) const
+        {
+            hash.addType(typeid(GLRCUBinary<L>));
+            this->m_base_obj.hashParams(hash);
+            hash.add(m_window_size);
+            hash.add(m_is_window_in_samples);
+        }
+        void saveState(SnapshotWriter &writer) const;
+        void loadState(SnapshotReader &reader);
 
     private:
-        std::deque<double> m_h1_mle_history;
+        // 64-bit, so that sums of up to window_size batches of INT_MAX samples do not overflow.
+        std::vector<std::int64_t> m_window_sums;
+        std::vector<std::int64_t> m_window_counts;
         int m_window_size{100};
+        bool m_is_window_in_samples{false};
+        std::size_t m_num_windows{0};
+        std::size_t m_oldest_pos{0};
+        int m_table_window_size{0};
+        std::shared_ptr<const std::vector<double>> m_max_llr_table;
+
+        void updateWindows(const std::int64_t &sum, const std::int64_t &n);
+        static double updateWindowsKernel(const L &base_obj,
+                                          const double *__restrict max_llr_table,
+                                          const int table_window_size,
+                                          std::int64_t *__restrict sums,
+                                          std::int64_t *__restrict counts,
+                                          const std::int64_t x,
+                                          const std::int64_t n,
+                                          const std::size_t k);
     };
 
+    // Constructors
+    template <typename L>
+    inline GLRCUBinary<L>::GLRCUBinary(const L &base_obj,
+                                       const int &window_size,
+                                       const bool &is_window_in_samples)
+        : LogLRE<L>::LogLRE(base_obj),
+          m_window_size{window_size},
+          m_is_window_in_samples{is_window_in_samples}
+    {
+        if (window_size <= 0)
+        {
+            throw std::runtime_error("Window size must be strictly positive.");
+        }
+        m_window_sums.resize(window_size);
+        m_window_counts.resize(window_size);
+
+        // Row n of the table starts at n * (n + 1) / 2 and has entries for k = 0, ..., n.
+        m_table_window_size = std::min(window_size, kMaxLLRTableWindowSize);
+        const std::size_t num_rows{static_cast<std::size_t>(m_table_window_size) + 1};
+        auto max_llr_table{std::make_shared<std::vector<double>>(num_rows * (num_rows + 1) / 2, 0.0)};
+        for (int n = 1; n <= m_table_window_size; n++)
+        {
+            const std::size_t row{static_cast<std::size_t>(n) * (n + 1) / 2};
+            for (int k = 0; k <= n; k++)
+            {
+                (*max_llr_table)[row + k] = base_obj.L::computeMaxLLRBySum(k, n);
+            }
+        }
+        m_max_llr_table = max_llr_table;
+    }
+
+    // Public members
+    template <typename L>
+    inline void GLRCUBinary<L>::updateLogValue(const double &x)
+    {
+        int x_int{0};
+        if (std::abs(x - 1.0) < kEps)
+        {
+            x_int = 1;
+        }
+        else if (std::abs(x) >= kEps)
+        {
+            throw std::runtime_error("Input must be either 0.0 or 1.0 or false or true.");
+        }
+        updateWindows(x_int, 1);
+    }
+
+    template <typename L>
+    inline void GLRCUBinary<L>::updateLogValueByAvg(const double &x_bar, const double &n)
+    {
+        const double n_round{std::round(n)};
+        if (n_round < 1.0 || std::abs(n - n_round) >= kEps * n_round ||
+            n_round > static_cast<double>(std::numeric_limits<int>::max()))
+        {
+            throw std::runtime_error("Sample size must be a positive integer for binary observations.");
+        }
+        const double sum{n * x_bar};
+        const double sum_round{std::round(sum)};
+        if (sum_round < 0.0 || sum_round > n_round || std::abs(sum - sum_round) >= kEps * n_round)
+        {
+            throw std::runtime_error("Number of successes n * x_bar must be an integer in [0, n].");
+        }
+        updateWindows(static_cast<std::int64_t>(sum_round), static_cast<std::int64_t>(n_round));
+    }
+
+    template <typename L>
+    inline void GLRCUBinary<L>::saveState(SnapshotWriter &writer) const
+    {
+        const std::size_t first_len{std::min(m_num_windows, m_window_sums.size() - m_oldest_pos)};
+        writer.write(this->m_log_value);
+        writer.write(static_cast<std::uint64_t>(m_num_windows));
+        writer.writeArray(m_window_sums.data() + m_oldest_pos, first_len);
+        writer.writeArray(m_window_sums.data(), m_num_windows - first_len);
+        writer.writeArray(m_window_counts.data() + m_oldest_pos, first_len);
+        writer.writeArray(m_window_counts.data(), m_num_windows - first_len);
+    }
+    template <typename L>
+    inline void GLRCUBinary<L>::loadState(SnapshotReader &reader)
+    {
+        const double log_value{reader.read<double>()};
+        const std::size_t num_windows{reader.readCount(m_window_sums.size())};
+        reader.checkRemainingSize(2 * num_windows * sizeof(std::int64_t));
+        std::vector<std::int64_t> sums(num_windows);
+        std::vector<std::int64_t> counts(num_windows);
+        reader.readArray(sums.data(), num_windows);
+        reader.readArray(counts.data(), num_windows);
+        // Counts index the table, so they are checked before the state is changed.
+        for (std::size_t i = 0; i < num_windows; i++)
+        {
+            if (counts[i] < 1 || sums[i] < 0 || sums[i] > counts[i])
+            {
+                throw std::runtime_error("Snapshot is corrupted.");
+            }
+        }
+        std::copy(sums.begin(), sums.end(), m_window_sums.begin());
+        std::copy(counts.begin(), counts.end(), m_window_counts.begin());
+        this->m_log_value = log_value;
+        m_num_windows = num_windows;
+        m_oldest_pos = 0;
+    }
+
+    // Private members
+    template <typename L>
+    inline void GLRCUBinary<L>::updateWindows(const std::int64_t &sum, const std::int64_t &n)
+    {
+        const std::size_t capacity{m_window_sums.size()};
+        if (m_is_window_in_samples)
+        {
+            // Counts are largest for the oldest windows.
+            while (m_num_windows > 0 && m_window_counts[m_oldest_pos] > m_window_size - n)
+            {
+                m_oldest_pos = (m_oldest_pos + 1) % capacity;
+                m_num_windows--;
+            }
+        }
+        // Open a new window starting from the batch, overwriting the oldest one if full.
+        if (m_num_windows == capacity)
+        {
+            m_oldest_pos = (m_oldest_pos + 1) % capacity;
+            m_num_windows--;
+        }
+        const std::size_t new_pos{(m_oldest_pos + m_num_windows) % capacity};
+        m_window_sums[new_pos] = 0;
+        m_window_counts[new_pos] = 0;
+        m_num_windows++;
+
+        const std::size_t first_len{std::min(m_num_windows, capacity - m_oldest_pos)};
+        double max_log_value{updateWindowsKernel(this->m_base_obj,
+                                                 m_max_llr_table->data(),
+                                                 m_table_window_size,
+                                                 m_window_sums.data() + m_oldest_pos,
+                                                 m_window_counts.data() + m_oldest_pos,
+                                                 sum,
+                                                 n,
+                                                 first_len)};
+        if (first_len < m_num_windows)
+        {
+            max_log_value = std::max(max_log_value,
+                                     updateWindowsKernel(this->m_base_obj,
+                                                         m_max_llr_table->data(),
+                                                         m_table_window_size,
+                                                         m_window_sums.data(),
+                                                         m_window_counts.data(),
+                                                         sum,
+                                                         n,
+                                                         m_num_windows - first_len));
+        }
+        this->m_log_value = max_log_value;
+    }
+
+    template <typename L>
+    inline double GLRCUBinary<L>::updateWindowsKernel(const L &base_obj,
+                                                      const double *__restrict max_llr_table,
+                                                      const int table_window_size,
+                                                      std::int64_t *__restrict sums,
+                                                      std::int64_t *__restrict counts,
+                                                      const std::int64_t x,
+                                                      const std::int64_t n,
+                                                      const std::size_t k)
+    {
+        double max_log_value{kNegInf};
+        for (std::size_t i = 0; i < k; i++)
+        {
+            sums[i] += x;
+            counts[i] += n;
+            const std::int64_t count{counts[i]};
+            double log_value_new{
+                count > 0 && count <= table_window_size
+                    ? max_llr_table[static_cast<std::size_t>(count) * (count + 1) / 2 + sums[i]]
+                    : base_obj.L::computeMaxLLRBySum(sums[i], count)};
+            max_log_value = std::max(max_log_value, log_value_new);
+        }
+        return max_log_value;
+    }
+
 } // End of namespace stcp
 #endif
\ No newline at end of file
@@ -33,6 +33,22 @@ namespace stcp
         {
             return n * ((h_1_mle - m_mu) / m_sig) * ((h_1_mle - m_mu) / m_sig) / 2.0;
         }
+        // Non-virtual version of computeMaxLLR taking the sum of n observations,
+        // which is called with the qualified name from vectorized window kernels.
+        // The LLR is written as (S - n * mu)^2 / (2 * n * sig^2) to use one division.
+        double computeMaxLLRBySum(const double &sum, const double &n) const
+        {
+            double sum_delta{sum - n * m_mu};
+            return sum_delta * sum_delta / (2.0 * n * m_sig * m_sig);
+        }
+        // Parameters checked by snapshots (see checkpoint.h).
+        void hashParams(ConfigHash &hash) const
+        {
+            hash.add(m_mu);
+            hash.add(m_sig);
+            hash.add(m_mu_delta_by_sig_squared);
+            hash.add(m_mu1_plus_mu_by_two);
+        }
 
     protected:
         double m_mu{0.0};
@@ -78,6 +94,11 @@ namespace stcp
             double h_1_mle_gt{std::max(h_1_mle, m_mu)};
             return n * ((h_1_mle_gt - m_mu) / m_sig) * ((h_1_mle_gt - m_mu) / m_sig) / 2.0;
         }
+        double computeMaxLLRBySum(const double &sum, const double &n) const
+        {
+            double sum_delta_gt{std::max(sum - n * m_mu, 0.0)};
+            return sum_delta_gt * sum_delta_gt / (2.0 * n * m_sig * m_sig);
+        }
     };
 
     class NormalGLRLess : public NormalGLR
@@ -90,6 +111,11 @@ namespace stcp
             double h_1_mle_ls{std::min(h_1_mle, m_mu)};
             return n * ((h_1_mle_ls - m_mu) / m_sig) * ((h_1_mle_ls - m_mu) / m_sig) / 2.0;
         }
+        double computeMaxLLRBySum(const double &sum, const double &n) const
+        {
+            double sum_delta_ls{std::min(sum - n * m_mu, 0.0)};
+            return sum_delta_ls * sum_delta_ls / (2.0 * n * m_sig * m_sig);
+        }
     };
 
     // Bernoulli
@@ -130,6 +156,17 @@ namespace stcp
         {
             return computeMaxLLRBer(m_p, h_1_mle, n);
         }
+        // Non-virtual version of computeMaxLLR taking the sum of n observations,
+        // which is called with the qualified name from window kernels.
+        double computeMaxLLRBySum(const double &sum, const double &n) const
+        {
+            return computeMaxLLRBer(m_p, sum / n, n);
+        }
+        void hashParams(ConfigHash &hash) const
+        {
+            hash.add(m_q);
+            hash.add(m_p);
+        }
 
     protected:
         double m_q{0.5};
@@ -152,10 +189,10 @@ namespace stcp
             m_log_base_val_x_one = log(q / p);
             m_log_base_val_x_zero = log((1 - q) / (1 - p));
         }
-        double computeMaxLLRBer(const double &p, const double &x_bar, const int &n);
+        double computeMaxLLRBer(const double &p, const double &x_bar, const double &n) const;
     };
 
-    inline double BerLR::computeMaxLLRBer(const double &p, const double &x_bar, const int &n)
+    inline double BerLR::computeMaxLLRBer(const double &p, const double &x_bar, const double &n) const
     {
         if (std::abs(x_bar) < kEps)
         {
@@ -191,6 +228,10 @@ namespace stcp
         {
             return computeMaxLLRBer(this->m_p, std::max(h_1_mle, this->m_p), n);
         }
+        double computeMaxLLRBySum(const double &sum, const double &n) const
+        {
+            return computeMaxLLRBer(this->m_p, std::max(sum / n, this->m_p), n);
+        }
     };
 
     class BerGLRLess : public BerGLR
@@ -202,6 +243,10 @@ namespace stcp
         {
             return computeMaxLLRBer(this->m_p, std::min(h_1_mle, this->m_p), n);
         }
+        double computeMaxLLRBySum(const double &sum, const double &n) const
+        {
+            return computeMaxLLRBer(this->m_p, std::min(sum / n, this->m_p), n);
+        }
     };
 
 } // End of namespace stcp
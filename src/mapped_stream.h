@@ -0,0 +1,306 @@
+#ifndef MAPPED_STREAM_H
+#define MAPPED_STREAM_H
+
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "stcp_interface.h"
+
+namespace stcp
+{
+    // Bytes of a file mapped at once. It is a multiple of the page size and of the
+    // allocation granularity of Windows (64KB), and of the size of every record,
+    // so views start at valid offsets and never split a record.
+    constexpr std::size_t kMappedViewSize{std::size_t{1} << 24};
+    // Records deinterleaved at once from a file of (x_bar, n) pairs.
+    constexpr std::size_t kMappedAvgChunkSize{std::size_t{1} << 14};
+
+    // Read-only file mapped in views of kMappedViewSize bytes.
+    // Only one view is mapped at a time and the previous one is unmapped,
+    // so the resident memory stays flat regardless of the file size.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string &path);
+        ~MappedFile();
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        std::size_t size() const { return m_size; }
+        // Pointer to the bytes [offset, offset + length) of the file, where offset is
+        // a multiple of kMappedViewSize and length <= kMappedViewSize.
+        // The pointer is valid until the next call.
+        const unsigned char *map(const std::size_t &offset, const std::size_t &length);
+
+    private:
+        std::size_t m_size{0};
+        void *m_view{nullptr};
+        std::size_t m_view_length{0};
+#ifdef _WIN32
+        HANDLE m_file{INVALID_HANDLE_VALUE};
+        HANDLE m_mapping{nullptr};
+#else
+        int m_fd{-1};
+#endif
+        void unmap();
+    };
+
+#ifdef _WIN32
+    inline MappedFile::MappedFile(const std::string &path)
+    {
+        m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Cannot open the file " + path + ".");
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size))
+        {
+            CloseHandle(m_file);
+            throw std::runtime_error("Cannot get the size of the file " + path + ".");
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+        if (m_size > 0)
+        {
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_mapping == nullptr)
+            {
+                CloseHandle(m_file);
+                throw std::runtime_error("Cannot map the file " + path + ".");
+            }
+        }
+    }
+    inline MappedFile::~MappedFile()
+    {
+        unmap();
+        if (m_mapping != nullptr)
+        {
+            CloseHandle(m_mapping);
+        }
+        CloseHandle(m_file);
+    }
+    inline const unsigned char *MappedFile::map(const std::size_t &offset, const std::size_t &length)
+    {
+        unmap();
+        const unsigned long long offset_64{offset};
+        m_view = MapViewOfFile(m_mapping, FILE_MAP_READ,
+                               static_cast<DWORD>(offset_64 >> 32),
+                               static_cast<DWORD>(offset_64 & 0xFFFFFFFFULL),
+                               length);
+        if (m_view == nullptr)
+        {
+            throw std::runtime_error("Cannot map a view of the file.");
+        }
+        m_view_length = length;
+        return static_cast<const unsigned char *>(m_view);
+    }
+    inline void MappedFile::unmap()
+    {
+        if (m_view != nullptr)
+        {
+            UnmapViewOfFile(m_view);
+            m_view = nullptr;
+        }
+    }
+#else
+    inline MappedFile::MappedFile(const std::string &path)
+    {
+        m_fd = ::open(path.c_str(), O_RDONLY);
+        if (m_fd < 0)
+        {
+            throw std::runtime_error("Cannot open the file " + path + ".");
+        }
+        struct stat st;
+        if (::fstat(m_fd, &st) != 0 || !S_ISREG(st.st_mode))
+        {
+            ::close(m_fd);
+            throw std::runtime_error("Cannot get the size of the file " + path + ".");
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+    }
+    inline MappedFile::~MappedFile()
+    {
+        unmap();
+        ::close(m_fd);
+    }
+    inline const unsigned char *MappedFile::map(const std::size_t &offset, const std::size_t &length)
+    {
+        unmap();
+        void *view{::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, m_fd, static_cast<off_t>(offset))};
+        if (view == MAP_FAILED)
+        {
+            throw std::runtime_error("Cannot map a view of the file.");
+        }
+        ::madvise(view, length, MADV_SEQUENTIAL);
+        m_view = view;
+        m_view_length = length;
+        return static_cast<const unsigned char *>(m_view);
+    }
+    inline void MappedFile::unmap()
+    {
+        if (m_view != nullptr)
+        {
+            ::munmap(m_view, m_view_length);
+            m_view = nullptr;
+        }
+    }
+#endif
+
+    // Result of streaming a file through a detector.
+    struct MappedStreamResult
+    {
+        // Records applied to the detector.
+        std::size_t num_records{0};
+        // True if the detector stopped for the first time at the record stop_record,
+        // a 0-based index in the file.
+        bool is_newly_stopped{false};
+        std::size_t stop_record{0};
+    };
+
+    // Streams the records of a flat binary file in the byte order of the host through stcp,
+    // from the record first_record to the end of the file.
+    // A record is a double x (updateLogValues) or, if is_avgs, a pair of doubles (x_bar, n)
+    // (updateLogValuesByAvgs). The file is read in place view by view, so neither the series
+    // nor a copy of it is materialized. If is_until_stop, records after the stop are not applied.
+    // As the vector methods, all inputs are checked before the first update when
+    // stcp->hasInputChecks() is true, at the cost of a second pass over the file.
+    inline MappedStreamResult streamMappedFile(IStcp *stcp,
+                                               const std::string &path,
+                                               const bool &is_avgs,
+                                               const bool &is_until_stop,
+                                               const std::size_t &first_record)
+    {
+        MappedFile file(path);
+        const std::size_t record_size{(is_avgs ? 2 : 1) * sizeof(double)};
+        if (file.size() % record_size != 0)
+        {
+            throw std::runtime_error(is_avgs ? "File size must be a multiple of 16 bytes for (x_bar, n) pairs."
+                                             : "File size must be a multiple of 8 bytes for doubles.");
+        }
+        const std::size_t num_records{file.size() / record_size};
+        if (first_record > num_records)
+        {
+            throw std::runtime_error("offset must not exceed the number of records in the file.");
+        }
+
+        // Calls f(records, first, n) for the records [first, first + n) of each view.
+        auto forEachView = [&](const auto &f)
+        {
+            const std::size_t records_per_view{kMappedViewSize / record_size};
+            std::size_t first{first_record};
+            while (first < num_records)
+            {
+                const std::size_t view_offset{first / records_per_view * kMappedViewSize};
+                const std::size_t view_length{std::min(kMappedViewSize, file.size() - view_offset)};
+                const unsigned char *view{file.map(view_offset, view_length)};
+                const std::size_t view_first{view_offset / record_size};
+                const std::size_t n{view_first + view_length / record_size - first};
+                const double *records{reinterpret_cast<const double *>(view + (first - view_first) * record_size)};
+                if (!f(records, first, n))
+                {
+                    return;
+                }
+                first += n;
+            }
+        };
+
+        if (!is_avgs && stcp->hasInputChecks())
+        {
+            forEachView([&](const double *xs, const std::size_t &, const std::size_t &n)
+                        {
+                            stcp->checkInputs(xs, n);
+                            return true; });
+        }
+
+        MappedStreamResult result;
+        if (is_until_stop && stcp->isStopped())
+        {
+            return result;
+        }
+        std::vector<double> x_bars;
+        std::vector<double> ns;
+        if (is_avgs)
+        {
+            x_bars.resize(kMappedAvgChunkSize);
+            ns.resize(kMappedAvgChunkSize);
+        }
+        forEachView([&](const double *records, const std::size_t &first, const std::size_t &n)
+                    {
+                        for (std::size_t start = 0; start < n; start += is_avgs ? kMappedAvgChunkSize : n)
+                        {
+                            const std::size_t len{is_avgs ? std::min(kMappedAvgChunkSize, n - start) : n};
+                            const double time{stcp->getTime()};
+                            const bool is_stopped_before{stcp->isStopped()};
+                            std::size_t num_applied{len};
+                            if (is_avgs)
+                            {
+                                for (std::size_t i = 0; i < len; i++)
+                                {
+                                    x_bars[i] = records[2 * (start + i)];
+                                    ns[i] = records[2 * (start + i) + 1];
+                                }
+                                if (is_until_stop)
+                                {
+                                    stcp->updateLogValuesUntilStopByAvgSpans(x_bars.data(), ns.data(), len);
+                                }
+                                else
+                                {
+                                    stcp->updateLogValuesByAvgSpans(x_bars.data(), ns.data(), len);
+                                }
+                            }
+                            else if (is_until_stop)
+                            {
+                                stcp->updateLogValuesUntilStopBySpan(records + start, len);
+                            }
+                            else
+                            {
+                                stcp->updateLogValuesBySpan(records + start, len);
+                            }
+
+                            if (!is_stopped_before && stcp->isStopped())
+                            {
+                                // The stopped time is reached by adding the sample sizes of the records
+                                // to the time in the same order as the detector does.
+                                std::size_t i{0};
+                                double stop_time{time};
+                                for (; i + 1 < len; i++)
+                                {
+                                    stop_time += is_avgs ? ns[i] : 1.0;
+                                    if (stop_time == stcp->getStoppedTime())
+                                    {
+                                        break;
+                                    }
+                                }
+                                result.is_newly_stopped = true;
+                                result.stop_record = first + start + i;
+                                if (is_until_stop)
+                                {
+                                    num_applied = i + 1;
+                                }
+                            }
+                            result.num_records += num_applied;
+                            if (is_until_stop && stcp->isStopped())
+                            {
+                                return false;
+                            }
+                        }
+                        return true; });
+        return result;
+    }
+} // End of namespace stcp
+#endif
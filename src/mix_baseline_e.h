@@ -0,0 +1,585 @@
+#ifndef MIX_BASELINE_E_H
+#define MIX_BASELINE_E_H
+
+#include "stcp_interface.h"
+#include "baseline_increment.h"
+#include "baseline_e.h"
+#include "mix_st_e.h"
+#include "worker_pool.h"
+
+namespace stcp
+{
+    // Non-virtual kernels over the components of a mixture stored as contiguous arrays,
+    // shared by MixBaselineE (one mixture) and StcpBank (one mixture per stream).
+    // Kernels take non-aliasing pointers and scalars by value
+    // so that the compiler can vectorize the loop over components
+    // (SSE2 / AVX2 on x86-64 and NEON on arm64).
+    template <typename E>
+    struct MixBaselineKernels
+    {
+        using L = typename E::BaseType;
+
+        static void updateLogValues(double *__restrict log_values,
+                                    const double *__restrict lambdas,
+                                    const double *__restrict offsets,
+                                    const double t,
+                                    const std::size_t k)
+        {
+            std::size_t i{0};
+            for (; i + kSimdBlockSize <= k; i += kSimdBlockSize)
+            {
+                for (std::size_t j = 0; j < kSimdBlockSize; j++)
+                {
+                    log_values[i + j] = E::kernelLogValue(log_values[i + j],
+                                                          L::kernelLogBaseValue(t, lambdas[i + j], offsets[i + j]));
+                }
+            }
+            for (; i < k; i++)
+            {
+                log_values[i] = E::kernelLogValue(log_values[i],
+                                                  L::kernelLogBaseValue(t, lambdas[i], offsets[i]));
+            }
+        }
+        static void updateLogValuesExact(double *__restrict log_values,
+                                         const double *__restrict lambdas,
+                                         const double *__restrict offsets,
+                                         const double t,
+                                         const std::size_t k)
+        {
+            for (std::size_t i = 0; i < k; i++)
+            {
+                log_values[i] = E::kernelLogValue(log_values[i],
+                                                  L::kernelLogBaseValueExact(t, lambdas[i], offsets[i]));
+            }
+        }
+        static void updateLogValuesByAvg(double *__restrict log_values,
+                                         const double *__restrict lambdas,
+                                         const double *__restrict offsets,
+                                         const double x_bar,
+                                         const double n,
+                                         const std::size_t k)
+        {
+            std::size_t i{0};
+            for (; i + kSimdBlockSize <= k; i += kSimdBlockSize)
+            {
+                for (std::size_t j = 0; j < kSimdBlockSize; j++)
+                {
+                    log_values[i + j] = E::kernelLogValue(log_values[i + j],
+                                                          L::kernelLogBaseValueByAvg(x_bar, n, lambdas[i + j], offsets[i + j]));
+                }
+            }
+            for (; i < k; i++)
+            {
+                log_values[i] = E::kernelLogValue(log_values[i],
+                                                  L::kernelLogBaseValueByAvg(x_bar, n, lambdas[i], offsets[i]));
+            }
+        }
+        // Extend the summaries of consecutive updates of SR / CU (see E::composeLogValue)
+        // of each component by one more input.
+        static void updateScanSummaries(double *__restrict log_slopes,
+                                        double *__restrict log_intercepts,
+                                        const double *__restrict lambdas,
+                                        const double *__restrict offsets,
+                                        const double t,
+                                        const std::size_t k)
+        {
+            std::size_t i{0};
+            for (; i + kSimdBlockSize <= k; i += kSimdBlockSize)
+            {
+                for (std::size_t j = 0; j < kSimdBlockSize; j++)
+                {
+                    const double log_base_value{L::kernelLogBaseValue(t, lambdas[i + j], offsets[i + j])};
+                    log_slopes[i + j] += log_base_value;
+                    log_intercepts[i + j] = E::kernelLogValue(log_intercepts[i + j], log_base_value);
+                }
+            }
+            for (; i < k; i++)
+            {
+                const double log_base_value{L::kernelLogBaseValue(t, lambdas[i], offsets[i])};
+                log_slopes[i] += log_base_value;
+                log_intercepts[i] = E::kernelLogValue(log_intercepts[i], log_base_value);
+            }
+        }
+        static void updateScanSummariesExact(double *__restrict log_slopes,
+                                             double *__restrict log_intercepts,
+                                             const double *__restrict lambdas,
+                                             const double *__restrict offsets,
+                                             const double t,
+                                             const std::size_t k)
+        {
+            for (std::size_t i = 0; i < k; i++)
+            {
+                const double log_base_value{L::kernelLogBaseValueExact(t, lambdas[i], offsets[i])};
+                log_slopes[i] += log_base_value;
+                log_intercepts[i] = E::kernelLogValue(log_intercepts[i], log_base_value);
+            }
+        }
+        // Write log(weight) + log value of each component and return their maximum,
+        // which is NaN if any of them is NaN.
+        static double updateLogWeightedValues(double *__restrict log_weighted_values,
+                                              const double *__restrict log_weights,
+                                              const double *__restrict log_values,
+                                              const std::size_t k)
+        {
+            double max_value{kNegInf};
+            for (std::size_t i = 0; i < k; i++)
+            {
+                log_weighted_values[i] = log_weights[i] + log_values[i];
+                max_value = maxOrNaN(max_value, log_weighted_values[i]);
+            }
+            return max_value;
+        }
+    };
+
+    // Implementation of mixture of baseline E-values / detectors
+    // stored as structure of arrays.
+    // Unlike MixE<E>, which keeps a full E object per component,
+    // MixBaselineE<E> keeps lambdas, offsets and log values in contiguous arrays
+    // and updates all components by the non-virtual kernels of
+    // E (ST, SR or CU) and its baseline increment L (Normal, Ber or Bounded).
+    template <typename E>
+    class MixBaselineE : public IGeneralE
+    {
+        static_assert(std::is_base_of<IGeneralE, E>::value, "Type must be derived from IGeneralE class.");
+
+    public:
+        using L = typename E::BaseType;
+
+        MixBaselineE();
+        MixBaselineE(const std::vector<L> &base_objs,
+                     const std::vector<double> &weights);
+
+        double getLogValue() override;
+        bool isLogValueAbove(const double &log_threshold) override;
+        void reset() override;
+        void updateLogValue(const double &x) override;
+        void updateLogValueByAvg(const double &x_bar, const double &n) override;
+
+        // Batch interface for inputs checked and transformed once per block
+        // by L::checkInputs and L::transformCheckedInputs (see StcpBounded).
+        void checkInputs(const double *xs, const std::size_t &n) const { m_base_obj.checkInputs(xs, n); }
+        void transformCheckedInputs(const double *xs, double *ts, const std::size_t &n) const
+        {
+            m_base_obj.transformCheckedInputs(xs, ts, n);
+        }
+        void updateLogValueByTransformedInput(const double &t);
+
+        // Update by all xs and write the log value after each of them to log_values_out,
+        // evaluating the recursions of SR / CU as a parallel scan over chunks of xs:
+        // (1) summarize each chunk but the last by the parameters of E::composeLogValue,
+        // (2) compose the summaries into the log values at the start of each chunk, and
+        // (3) rerun all chunks from their starts and write their log values.
+        // Phases (1) and (3) run on the pool. The object is updated only if all inputs are valid.
+        void updateLogValuesByScan(const std::vector<double> &xs, double *log_values_out, WorkerPool &pool);
+
+        // Binary inputs of Ber packed in the bits of a byte, least significant bit first
+        // (see Stcp::updateLogValuesByBits). Eight inputs are applied at once through tables of
+        // E::composeLogValue parameters of every byte value if the log value cannot exceed
+        // log_threshold after any of them, and nothing is applied otherwise.
+        // Return true if the inputs are applied.
+        static constexpr int kMaxPackedBits{8};
+        bool updateLogValueByBitsIfBelow(const std::uint64_t &bits,
+                                         const int &num_bits,
+                                         const double &log_threshold);
+
+        std::vector<double> getWeights() { return m_weights; }
+        std::vector<double> getLambdas() { return m_lambdas; }
+        std::vector<double> getLogValues() { return m_log_values; }
+
+        // Snapshots of the state (see Stcp::saveState). Only the log values of the components
+        // are stored, and loadState reads them from the rest of the snapshot.
+        void hashConfig(ConfigHash &hash) const;
+        void saveState(SnapshotWriter &writer) const;
+        void loadState(SnapshotReader &reader);
+
+        void print();
+
+    protected:
+        // Shared input transform (mu, sig or p) of all components.
+        L m_base_obj;
+        std::vector<double> m_lambdas;
+        double m_lambda_min{0.0};
+        double m_lambda_max{0.0};
+        std::vector<double> m_offsets;
+        std::vector<double> m_weights;
+        std::vector<double> m_log_weights;
+        std::vector<double> m_log_values;
+        // Preallocated buffer of log(weight) + log value of each component
+        // and its running maximum, kept in sync with every update
+        // so that getLogValue does not allocate.
+        std::vector<double> m_log_weighted_values;
+        double m_max_log_weighted_value{kNegInf};
+        double m_log_num_components{0.0};
+        void updateLogWeightedValues();
+        std::vector<double> validateAndComputeLogWeights(const std::vector<double> &weights);
+
+        // Row v * k + i summarizes the updates of the component i by the bits of the byte v.
+        // Peaks are the maxima of the parameters over the prefixes of the byte, so that
+        // E::composeLogValue of them bounds the log value after each of the eight inputs.
+        // Tables are built on the first packed update.
+        std::vector<double> m_byte_log_slopes;
+        std::vector<double> m_byte_log_intercepts;
+        std::vector<double> m_byte_peak_log_slopes;
+        std::vector<double> m_byte_peak_log_intercepts;
+        void buildByteTables();
+
+        // Chunks of the parallel scan per thread, and the smallest chunk worth a task.
+        static constexpr std::size_t kScanChunksPerThread{4};
+        static constexpr std::size_t kMinScanChunkSize{1024};
+
+    };
+
+    // Constructors
+    template <typename E>
+    inline MixBaselineE<E>::MixBaselineE()
+        : MixBaselineE<E>::MixBaselineE(std::vector<L>(1),
+                                        std::vector<double>{1.0})
+    {
+    }
+    template <typename E>
+    inline MixBaselineE<E>::MixBaselineE(const std::vector<L> &base_objs,
+                                         const std::vector<double> &weights)
+        : m_weights{weights},
+          m_log_weights{validateAndComputeLogWeights(weights)}
+    {
+        if (base_objs.size() != weights.size())
+        {
+            throw std::runtime_error("Baseline objects and Weights do not have the same length.");
+        }
+        m_base_obj = base_objs[0];
+        m_lambdas.reserve(base_objs.size());
+        m_offsets.reserve(base_objs.size());
+        for (auto &base_obj : base_objs)
+        {
+            m_lambdas.push_back(base_obj.getLambda());
+            m_offsets.push_back(base_obj.getLogBaseOffset());
+        }
+        m_lambda_min = *std::min_element(m_lambdas.begin(), m_lambdas.end());
+        m_lambda_max = *std::max_element(m_lambdas.begin(), m_lambdas.end());
+        m_log_values.assign(base_objs.size(), E::initialLogValue());
+        m_log_num_components = std::log(static_cast<double>(weights.size()));
+        m_log_weighted_values.resize(base_objs.size());
+        updateLogWeightedValues();
+    }
+
+    // Public members
+    template <typename E>
+    inline double MixBaselineE<E>::getLogValue()
+    {
+        if (m_log_weighted_values.size() == 1)
+        {
+            // Since weight must be equal to 1 by the construction,
+            // we do not need to take account of it.
+            return m_log_values[0];
+        }
+
+        return logSumExpWithMax(m_log_weighted_values.data(),
+                                m_log_weighted_values.size(),
+                                m_max_log_weighted_value);
+    }
+
+    template <typename E>
+    inline bool MixBaselineE<E>::isLogValueAbove(const double &log_threshold)
+    {
+        // max_i(log w_i + log e_i) <= log value <= max_i(log w_i + log e_i) + log k
+        // The exact log-sum-exp is needed only if the two bounds straddle the threshold.
+        if (m_max_log_weighted_value > log_threshold)
+        {
+            return true;
+        }
+        if (m_max_log_weighted_value + m_log_num_components <= log_threshold)
+        {
+            return false;
+        }
+        return getLogValue() > log_threshold;
+    }
+
+    template <typename E>
+    inline void MixBaselineE<E>::reset()
+    {
+        std::fill(m_log_values.begin(), m_log_values.end(), E::initialLogValue());
+        updateLogWeightedValues();
+    }
+
+    template <typename E>
+    inline void MixBaselineE<E>::hashConfig(ConfigHash &hash) const
+    {
+        hash.addType(typeid(MixBaselineE<E>));
+        m_base_obj.hashParams(hash);
+        hash.add(m_lambdas);
+        hash.add(m_offsets);
+        hash.add(m_weights);
+    }
+    template <typename E>
+    inline void MixBaselineE<E>::saveState(SnapshotWriter &writer) const
+    {
+        writer.writeArray(m_log_values.data(), m_log_values.size());
+    }
+    template <typename E>
+    inline void MixBaselineE<E>::loadState(SnapshotReader &reader)
+    {
+        reader.checkRemainingSize(m_log_values.size() * sizeof(double));
+        reader.readArray(m_log_values.data(), m_log_values.size());
+        updateLogWeightedValues();
+    }
+
+    template <typename E>
+    inline void MixBaselineE<E>::updateLogValue(const double &x)
+    {
+        // The input check and transform are shared by all components.
+        updateLogValueByTransformedInput(m_base_obj.transformInput(x));
+    }
+
+    template <typename E>
+    inline void MixBaselineE<E>::updateLogValueByTransformedInput(const double &t)
+    {
+        if (L::isKernelInputInRange(t, m_lambda_min, m_lambda_max))
+        {
+            MixBaselineKernels<E>::updateLogValues(m_log_values.data(),
+                                                   m_lambdas.data(),
+                                                   m_offsets.data(),
+                                                   t,
+                                                   m_log_values.size());
+        }
+        else
+        {
+            MixBaselineKernels<E>::updateLogValuesExact(m_log_values.data(),
+                                                        m_lambdas.data(),
+                                                        m_offsets.data(),
+                                                        t,
+                                                        m_log_values.size());
+        }
+        updateLogWeightedValues();
+    }
+
+    template <typename E>
+    inline void MixBaselineE<E>::updateLogValueByAvg(const double &x_bar, const double &n)
+    {
+        MixBaselineKernels<E>::updateLogValuesByAvg(m_log_values.data(),
+                                                    m_lambdas.data(),
+                                                    m_offsets.data(),
+                                                    x_bar,
+                                                    n,
+                                                    m_log_values.size());
+        updateLogWeightedValues();
+    }
+
+    template <typename E>
+    inline void MixBaselineE<E>::updateLogValuesByScan(const std::vector<double> &xs,
+                                                       double *log_values_out,
+                                                       WorkerPool &pool)
+    {
+        const std::size_t n{xs.size()};
+        const std::size_t k{m_log_values.size()};
+        const std::size_t num_chunks{std::max<std::size_t>(
+            1, std::min(static_cast<std::size_t>(pool.getNumThreads()) * kScanChunksPerThread,
+                        n / kMinScanChunkSize))};
+        auto chunkBegin = [n, num_chunks](const std::size_t &c)
+        { return c * n / num_chunks; };
+
+        // (1) Each row of k values summarizes the chunk c < num_chunks - 1.
+        std::vector<double> log_slopes((num_chunks - 1) * k, 0.0);
+        std::vector<double> log_intercepts((num_chunks - 1) * k, kNegInf);
+        pool.run(num_chunks - 1, [&](std::size_t c)
+                 {
+                     double *chunk_log_slopes{log_slopes.data() + c * k};
+                     double *chunk_log_intercepts{log_intercepts.data() + c * k};
+                     for (std::size_t i = chunkBegin(c); i < chunkBegin(c + 1); i++)
+                     {
+                         const double t{m_base_obj.transformInput(xs[i])};
+                         if (L::isKernelInputInRange(t, m_lambda_min, m_lambda_max))
+                         {
+                             MixBaselineKernels<E>::updateScanSummaries(chunk_log_slopes, chunk_log_intercepts,
+                                                                        m_lambdas.data(), m_offsets.data(), t, k);
+                         }
+                         else
+                         {
+                             MixBaselineKernels<E>::updateScanSummariesExact(chunk_log_slopes, chunk_log_intercepts,
+                                                                             m_lambdas.data(), m_offsets.data(), t, k);
+                         }
+                     } });
+
+        // (2) Row c holds the log values at the start of the chunk c.
+        std::vector<double> chunk_log_values(num_chunks * k);
+        std::copy(m_log_values.begin(), m_log_values.end(), chunk_log_values.begin());
+        for (std::size_t c = 0; c + 1 < num_chunks; c++)
+        {
+            for (std::size_t i = 0; i < k; i++)
+            {
+                chunk_log_values[(c + 1) * k + i] = E::composeLogValue(chunk_log_values[c * k + i],
+                                                                       log_slopes[c * k + i],
+                                                                       log_intercepts[c * k + i]);
+            }
+        }
+
+        // (3) Each chunk advances its own row, which ends at the start of the next chunk.
+        pool.run(num_chunks, [&](std::size_t c)
+                 {
+                     double *log_values{chunk_log_values.data() + c * k};
+                     std::vector<double> log_weighted_values(k);
+                     for (std::size_t i = chunkBegin(c); i < chunkBegin(c + 1); i++)
+                     {
+                         const double t{m_base_obj.transformInput(xs[i])};
+                         if (L::isKernelInputInRange(t, m_lambda_min, m_lambda_max))
+                         {
+                             MixBaselineKernels<E>::updateLogValues(log_values, m_lambdas.data(), m_offsets.data(), t, k);
+                         }
+                         else
+                         {
+                             MixBaselineKernels<E>::updateLogValuesExact(log_values, m_lambdas.data(), m_offsets.data(), t, k);
+                         }
+                         if (k == 1)
+                         {
+                             log_values_out[i] = log_values[0];
+                             continue;
+                         }
+                         const double max_value{
+                             MixBaselineKernels<E>::updateLogWeightedValues(log_weighted_values.data(),
+                                                                            m_log_weights.data(),
+                                                                            log_values,
+                                                                            k)};
+                         log_values_out[i] = logSumExpWithMax(log_weighted_values.data(), k, max_value);
+                     } });
+
+        std::copy(chunk_log_values.end() - k, chunk_log_values.end(), m_log_values.begin());
+        updateLogWeightedValues();
+    }
+
+    template <typename E>
+    inline bool MixBaselineE<E>::updateLogValueByBitsIfBelow(const std::uint64_t &bits,
+                                                             const int &num_bits,
+                                                             const double &log_threshold)
+    {
+        if (num_bits != kMaxPackedBits)
+        {
+            return false;
+        }
+        if (m_byte_log_slopes.empty())
+        {
+            buildByteTables();
+        }
+        const std::size_t k{m_log_values.size()};
+        const std::size_t row{static_cast<std::size_t>(bits) * k};
+        if (log_threshold < kPosInf)
+        {
+            // Same bounds as isLogValueAbove, applied to the peaks of all components.
+            // composeLogValue of both SR and CU is at most max(log_value + log_slope, log_intercept) + log(2).
+            double max_peak{kNegInf};
+            for (std::size_t i = 0; i < k; i++)
+            {
+                max_peak = std::max(max_peak,
+                                    m_log_weights[i] + std::max(m_log_values[i] + m_byte_peak_log_slopes[row + i],
+                                                                m_byte_peak_log_intercepts[row + i]));
+            }
+            if (max_peak + m_log_num_components + kLog2 > log_threshold)
+            {
+                return false;
+            }
+        }
+        for (std::size_t i = 0; i < k; i++)
+        {
+            m_log_values[i] = E::composeLogValue(m_log_values[i],
+                                                 m_byte_log_slopes[row + i],
+                                                 m_byte_log_intercepts[row + i]);
+        }
+        updateLogWeightedValues();
+        return true;
+    }
+
+    template <typename E>
+    inline void MixBaselineE<E>::print()
+    {
+        std::cout << "weights: " << std::endl;
+        for (auto &w : m_weights)
+        {
+            std::cout << w << ' ';
+        }
+        std::cout << '\n';
+        std::cout << "lambdas: " << std::endl;
+        for (auto &lambda : m_lambdas)
+        {
+            std::cout << lambda << ' ';
+        }
+        std::cout << '\n';
+        std::cout << "log of values: " << std::endl;
+        for (auto &log_value : m_log_values)
+        {
+            std::cout << log_value << ' ';
+        }
+        std::cout << '\n';
+    }
+    // Private members
+    template <typename E>
+    inline void MixBaselineE<E>::updateLogWeightedValues()
+    {
+        m_max_log_weighted_value =
+            MixBaselineKernels<E>::updateLogWeightedValues(m_log_weighted_values.data(),
+                                                           m_log_weights.data(),
+                                                           m_log_values.data(),
+                                                           m_log_values.size());
+    }
+    template <typename E>
+    inline void MixBaselineE<E>::buildByteTables()
+    {
+        constexpr std::size_t kNumByteValues{256};
+        const std::size_t k{m_log_values.size()};
+        m_byte_log_slopes.assign(kNumByteValues * k, 0.0);
+        m_byte_log_intercepts.assign(kNumByteValues * k, kNegInf);
+        m_byte_peak_log_slopes.assign(kNumByteValues * k, kNegInf);
+        m_byte_peak_log_intercepts.assign(kNumByteValues * k, kNegInf);
+        for (std::size_t v = 0; v < kNumByteValues; v++)
+        {
+            for (std::size_t i = 0; i < k; i++)
+            {
+                const std::size_t pos{v * k + i};
+                for (int j = 0; j < kMaxPackedBits; j++)
+                {
+                    const double t{static_cast<double>((v >> j) & 1)};
+                    const double log_base_value{L::kernelLogBaseValueExact(t, m_lambdas[i], m_offsets[i])};
+                    m_byte_log_slopes[pos] += log_base_value;
+                    m_byte_log_intercepts[pos] = E::kernelLogValue(m_byte_log_intercepts[pos], log_base_value);
+                    m_byte_peak_log_slopes[pos] = std::max(m_byte_peak_log_slopes[pos], m_byte_log_slopes[pos]);
+                    m_byte_peak_log_intercepts[pos] = std::max(m_byte_peak_log_intercepts[pos], m_byte_log_intercepts[pos]);
+                }
+            }
+        }
+    }
+    template <typename E>
+    inline std::vector<double> MixBaselineE<E>::validateAndComputeLogWeights(const std::vector<double> &weights)
+    {
+        double weights_sum{0.0};
+        std::vector<double> log_weights;
+        log_weights.reserve(weights.size());
+        for (auto &w : weights)
+        {
+            if (w <= 0)
+            {
+                throw std::runtime_error("All weights must be strictly positive.");
+            }
+            weights_sum += w;
+            log_weights.push_back(std::log(w));
+        }
+        if (std::abs(weights_sum - 1.0) > kEps)
+        {
+            throw std::runtime_error("Sum of weights is not equal to 1.");
+        }
+
+        return log_weights;
+    }
+
+    // ST mixtures of linear baseline increments only need (S_n, n) as their state.
+    template <>
+    class MixBaselineE<ST<Normal>> : public MixSTE<Normal>
+    {
+    public:
+        using MixSTE<Normal>::MixSTE;
+    };
+    template <>
+    class MixBaselineE<ST<Ber>> : public MixSTE<Ber>
+    {
+    public:
+        using MixSTE<Ber>::MixSTE;
+    };
+
+} // End of namespace stcp
+#endif
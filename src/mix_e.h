@@ -18,6 +18,7 @@ namespace stcp
              const std::vector<double> &weights);
 
         double getLogValue() override;
+        bool isLogValueAbove(const double &log_threshold) override;
         void reset() override;
         void updateLogValue(const double &x) override;
         void updateLogValueByAvg(const double &x_bar, const double &n) override;
@@ -31,6 +32,13 @@ namespace stcp
         std::vector<E> m_e_objs;
         std::vector<double> m_weights;
         std::vector<double> m_log_weights;
+        // Preallocated buffer of log(weight) + log value of each component
+        // and its running maximum, kept in sync with every update
+        // so that getLogValue does not allocate.
+        std::vector<double> m_log_weighted_values;
+        double m_max_log_weighted_value{kNegInf};
+        double m_log_num_components{0.0};
+        void updateLogWeightedValues();
         std::vector<double> validateAndComputeLogWeights(const std::vector<double> &weights);
     };
 
@@ -59,25 +67,41 @@ namespace stcp
         {
             throw std::runtime_error("E objects and Weights do not have the same length.");
         }
+        m_log_num_components = std::log(static_cast<double>(weights.size()));
+        m_log_weighted_values.resize(e_objs.size());
+        updateLogWeightedValues();
     }
 
     // Public members
     template <typename E>
     inline double MixE<E>::getLogValue()
     {
-        if (m_e_objs.size() == 1)
+        if (m_log_weighted_values.size() == 1)
         {
             // Since weight must be equal to 1 by the construction,
             // we do not need to take account of it.
             return m_e_objs[0].getLogValue();
         }
-        auto log_wls{m_log_weights};
-        for (std::size_t i = 0; i < log_wls.size(); i++)
+
+        return logSumExpWithMax(m_log_weighted_values.data(),
+                                m_log_weighted_values.size(),
+                                m_max_log_weighted_value);
+    }
+
+    template <typename E>
+    inline bool MixE<E>::isLogValueAbove(const double &log_threshold)
+    {
+        // max_i(log w_i + log e_i) <= log value <= max_i(log w_i + log e_i) + log k
+        // The exact log-sum-exp is needed only if the two bounds straddle the threshold.
+        if (m_max_log_weighted_value > log_threshold)
         {
-            log_wls[i] += m_e_objs[i].getLogValue();
+            return true;
         }
-
-        return logSumExp(log_wls);
+        if (m_max_log_weighted_value + m_log_num_components <= log_threshold)
+        {
+            return false;
+        }
+        return getLogValue() > log_threshold;
     }
 
     template <typename E>
@@ -87,6 +111,7 @@ namespace stcp
         {
             e_obj.reset();
         }
+        updateLogWeightedValues();
     }
 
     template <typename E>
@@ -96,6 +121,7 @@ namespace stcp
         {
             e_obj.updateLogValue(x);
         }
+        updateLogWeightedValues();
     }
 
     template <typename E>
@@ -105,6 +131,7 @@ namespace stcp
         {
             e_obj.updateLogValueByAvg(x_bar, n);
         }
+        updateLogWeightedValues();
     }
 
     template <typename E>
@@ -136,6 +163,17 @@ namespace stcp
     }
     // Private members
     template <typename E>
+    inline void MixE<E>::updateLogWeightedValues()
+    {
+        double max_value{kNegInf};
+        for (std::size_t i = 0; i < m_e_objs.size(); i++)
+        {
+            m_log_weighted_values[i] = m_log_weights[i] + m_e_objs[i].getLogValue();
+            max_value = maxOrNaN(max_value, m_log_weighted_values[i]);
+        }
+        m_max_log_weighted_value = max_value;
+    }
+    template <typename E>
     inline std::vector<double> MixE<E>::validateAndComputeLogWeights(const std::vector<double> &weights)
     {
         double weights_sum{0.0};
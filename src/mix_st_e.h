@@ -0,0 +1,383 @@
+#ifndef MIX_ST_E_H
+#define MIX_ST_E_H
+
+#include <memory>
+
+#include "stcp_interface.h"
+#include "baseline_increment.h"
+
+namespace stcp
+{
+    // Implementation of mixture of ST e-values for linear baseline increments
+    // (Normal and Ber), whose log values are
+    // log(e_i) = lambda_i * S_n - n * offset_i
+    // where S_n is the running sum of transformed inputs.
+    // The state of the whole mixture is (S_n, n), so updates cost O(1)
+    // regardless of the number of components, and the mixture is evaluated
+    // lazily when the value is read or the threshold is checked.
+    // Parameters are shared between copies, so the memory per detector is constant.
+    template <typename L>
+    class MixSTE : public IGeneralE
+    {
+        static_assert(
+            std::is_base_of<Normal, L>::value || std::is_base_of<Ber, L>::value,
+            "Type must be derived from Normal or Ber class.");
+
+    public:
+        MixSTE();
+        MixSTE(const std::vector<L> &base_objs,
+               const std::vector<double> &weights);
+
+        double getLogValue() override;
+        bool isLogValueAbove(const double &log_threshold) override;
+        void reset() override;
+        void updateLogValue(const double &x) override;
+        void updateLogValueByAvg(const double &x_bar, const double &n) override;
+
+        std::vector<double> getWeights() { return m_params->weights; }
+        std::vector<double> getLambdas() { return m_params->lambdas; }
+        std::vector<double> getLogValues();
+
+        // Binary inputs packed in the bits of a word, least significant bit first
+        // (see Stcp::updateLogValuesByBits). num_bits <= kMaxPackedBits inputs are applied
+        // at once by a popcount if the log value cannot exceed log_threshold after any of them,
+        // and nothing is applied otherwise. Return true if the inputs are applied.
+        static constexpr int kMaxPackedBits{64};
+        bool updateLogValueByBitsIfBelow(const std::uint64_t &bits,
+                                         const int &num_bits,
+                                         const double &log_threshold);
+
+        double getSum() { return m_sum; }
+        double getCount() { return m_n; }
+
+        // Snapshots of the state (see Stcp::saveState), which is the running sum and count.
+        void hashConfig(ConfigHash &hash) const;
+        void saveState(SnapshotWriter &writer) const;
+        void loadState(SnapshotReader &reader);
+
+        void print();
+
+    protected:
+        struct Params
+        {
+            // Shared input transform (mu, sig or p) of all components.
+            L base_obj;
+            std::vector<double> lambdas;
+            std::vector<double> offsets;
+            std::vector<double> weights;
+            std::vector<double> log_weights;
+            // log of the sum of weights, which is zero up to kEps.
+            double log_weights_sum{0.0};
+            // Largest increment of any component log value by an input 0 or 1, or zero.
+            double max_binary_log_base_value{0.0};
+            // Indices of components on the upper envelope of
+            // the lines S -> lambda_i * S - n * offset_i, sorted by lambda.
+            std::vector<std::size_t> envelope;
+        };
+        std::shared_ptr<const Params> m_params;
+
+        double m_sum{0.0};
+        double m_n{0.0};
+        double m_log_value{0.0};
+        bool m_is_log_value_updated{true};
+        std::size_t m_envelope_pos{0};
+
+        double computeLogBaseSum(const std::size_t &i) const
+        {
+            return m_params->lambdas[i] * m_sum - m_n * m_params->offsets[i];
+        }
+        double computeMaxLogBaseSum();
+        static std::shared_ptr<const Params> buildParams(const std::vector<L> &base_objs,
+                                                         const std::vector<double> &weights);
+    };
+
+    // Constructors
+    template <typename L>
+    inline MixSTE<L>::MixSTE()
+        : MixSTE<L>::MixSTE(std::vector<L>(1),
+                            std::vector<double>{1.0})
+    {
+    }
+    template <typename L>
+    inline MixSTE<L>::MixSTE(const std::vector<L> &base_objs,
+                             const std::vector<double> &weights)
+        : m_params{buildParams(base_objs, weights)}
+    {
+    }
+
+    // Public members
+    template <typename L>
+    inline double MixSTE<L>::getLogValue()
+    {
+        if (m_is_log_value_updated)
+        {
+            return m_log_value;
+        }
+        const Params &params{*m_params};
+        const std::size_t k{params.lambdas.size()};
+        if (k == 1)
+        {
+            // Since weight must be equal to 1 by the construction,
+            // we do not need to take account of it.
+            m_log_value = computeLogBaseSum(0);
+        }
+        else
+        {
+            // Two passes without a buffer to keep the state constant in size.
+            double max_value{kNegInf};
+            for (std::size_t i = 0; i < k; i++)
+            {
+                max_value = maxOrNaN(max_value, params.log_weights[i] + computeLogBaseSum(i));
+            }
+            if (std::isnan(max_value))
+            {
+                // The sum below skips terms by a comparison that is false for NaN,
+                // so a NaN state, e.g. after a NaN observation, is kept as is.
+                m_log_value = max_value;
+            }
+            else
+            {
+                double sum_exp{0.0};
+                for (std::size_t i = 0; i < k; i++)
+                {
+                    double x_centered{params.log_weights[i] + computeLogBaseSum(i) - max_value};
+                    if (x_centered > kLogEps)
+                    {
+                        sum_exp += std::exp(x_centered);
+                    }
+                }
+                m_log_value = log(sum_exp) + max_value;
+            }
+        }
+        m_is_log_value_updated = true;
+
+        return m_log_value;
+    }
+
+    template <typename L>
+    inline bool MixSTE<L>::isLogValueAbove(const double &log_threshold)
+    {
+        // Since weights sum to one, the mixture is bounded above by
+        // the maximum of the component log values, which is tracked on
+        // the upper envelope in amortized O(1).
+        if (!m_is_log_value_updated && m_n > 0.0)
+        {
+            if (computeMaxLogBaseSum() + m_params->log_weights_sum <= log_threshold)
+            {
+                return false;
+            }
+        }
+        return getLogValue() > log_threshold;
+    }
+
+    template <typename L>
+    inline void MixSTE<L>::reset()
+    {
+        m_sum = 0.0;
+        m_n = 0.0;
+        m_log_value = 0.0;
+        m_is_log_value_updated = true;
+    }
+
+    template <typename L>
+    inline void MixSTE<L>::updateLogValue(const double &x)
+    {
+        m_sum += m_params->base_obj.transformInput(x);
+        m_n += 1.0;
+        m_is_log_value_updated = false;
+    }
+
+    template <typename L>
+    inline void MixSTE<L>::updateLogValueByAvg(const double &x_bar, const double &n)
+    {
+        m_sum += n * x_bar;
+        m_n += n;
+        m_is_log_value_updated = false;
+    }
+
+    template <typename L>
+    inline bool MixSTE<L>::updateLogValueByBitsIfBelow(const std::uint64_t &bits,
+                                                       const int &num_bits,
+                                                       const double &log_threshold)
+    {
+        // Each input raises every component log value by at most max_binary_log_base_value,
+        // so the mixture stays below max_i(log e_i) + num_bits * max_binary_log_base_value.
+        if (log_threshold < kPosInf &&
+            computeMaxLogBaseSum() + m_params->log_weights_sum +
+                    num_bits * m_params->max_binary_log_base_value >
+                log_threshold)
+        {
+            return false;
+        }
+        m_sum += popcount64(bits);
+        m_n += num_bits;
+        m_is_log_value_updated = false;
+        return true;
+    }
+
+    template <typename L>
+    inline void MixSTE<L>::hashConfig(ConfigHash &hash) const
+    {
+        hash.addType(typeid(MixSTE<L>));
+        m_params->base_obj.hashParams(hash);
+        hash.add(m_params->lambdas);
+        hash.add(m_params->offsets);
+        hash.add(m_params->weights);
+    }
+    template <typename L>
+    inline void MixSTE<L>::saveState(SnapshotWriter &writer) const
+    {
+        writer.write(m_sum);
+        writer.write(m_n);
+    }
+    template <typename L>
+    inline void MixSTE<L>::loadState(SnapshotReader &reader)
+    {
+        reader.checkRemainingSize(2 * sizeof(double));
+        m_sum = reader.read<double>();
+        m_n = reader.read<double>();
+        // The log value is evaluated lazily as after an update, or is zero as after reset().
+        m_log_value = 0.0;
+        m_is_log_value_updated = m_n == 0.0;
+        m_envelope_pos = 0;
+    }
+
+    template <typename L>
+    inline std::vector<double> MixSTE<L>::getLogValues()
+    {
+        std::vector<double> log_values(m_params->lambdas.size());
+        for (std::size_t i = 0; i < log_values.size(); i++)
+        {
+            log_values[i] = computeLogBaseSum(i);
+        }
+        return log_values;
+    }
+
+    template <typename L>
+    inline void MixSTE<L>::print()
+    {
+        std::cout << "weights: " << std::endl;
+        for (auto &w : m_params->weights)
+        {
+            std::cout << w << ' ';
+        }
+        std::cout << '\n';
+        std::cout << "sum and count: " << std::endl;
+        std::cout << m_sum << ' ' << m_n << '\n';
+    }
+
+    // Private members
+    template <typename L>
+    inline double MixSTE<L>::computeMaxLogBaseSum()
+    {
+        // Walk along the envelope from the last maximizer.
+        // S_n / n moves slowly, so only a few steps are needed per observation.
+        const std::vector<std::size_t> &envelope{m_params->envelope};
+        std::size_t pos{m_envelope_pos};
+        double max_value{computeLogBaseSum(envelope[pos])};
+        while (pos + 1 < envelope.size())
+        {
+            double next_value{computeLogBaseSum(envelope[pos + 1])};
+            if (next_value < max_value)
+            {
+                break;
+            }
+            max_value = next_value;
+            pos++;
+        }
+        while (pos > 0)
+        {
+            double prev_value{computeLogBaseSum(envelope[pos - 1])};
+            if (prev_value <= max_value)
+            {
+                break;
+            }
+            max_value = prev_value;
+            pos--;
+        }
+        m_envelope_pos = pos;
+
+        return max_value;
+    }
+
+    template <typename L>
+    inline std::shared_ptr<const typename MixSTE<L>::Params> MixSTE<L>::buildParams(
+        const std::vector<L> &base_objs,
+        const std::vector<double> &weights)
+    {
+        auto params{std::make_shared<Params>()};
+        double weights_sum{0.0};
+        for (auto &w : weights)
+        {
+            if (w <= 0)
+            {
+                throw std::runtime_error("All weights must be strictly positive.");
+            }
+            weights_sum += w;
+            params->log_weights.push_back(std::log(w));
+        }
+        if (std::abs(weights_sum - 1.0) > kEps)
+        {
+            throw std::runtime_error("Sum of weights is not equal to 1.");
+        }
+        if (base_objs.size() != weights.size())
+        {
+            throw std::runtime_error("Baseline objects and Weights do not have the same length.");
+        }
+        params->weights = weights;
+        params->log_weights_sum = std::log(weights_sum);
+        params->base_obj = base_objs[0];
+        for (auto &base_obj : base_objs)
+        {
+            params->lambdas.push_back(base_obj.getLambda());
+            params->offsets.push_back(base_obj.getLogBaseOffset());
+            params->max_binary_log_base_value = std::max({params->max_binary_log_base_value,
+                                                          base_obj.getLambda() - base_obj.getLogBaseOffset(),
+                                                          -base_obj.getLogBaseOffset()});
+        }
+
+        // Upper envelope of lines with slopes lambda_i and intercepts -offset_i.
+        const std::vector<double> &slopes{params->lambdas};
+        const std::vector<double> &offsets{params->offsets};
+        std::vector<std::size_t> order(slopes.size());
+        for (std::size_t i = 0; i < order.size(); i++)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(),
+                  [&](const std::size_t &a, const std::size_t &b)
+                  {
+                      return slopes[a] < slopes[b] ||
+                             (slopes[a] == slopes[b] && offsets[a] > offsets[b]);
+                  });
+        std::vector<std::size_t> &envelope{params->envelope};
+        for (auto &i : order)
+        {
+            if (!envelope.empty() && slopes[envelope.back()] == slopes[i])
+            {
+                // Same slope with a larger offset is dominated.
+                continue;
+            }
+            while (envelope.size() >= 2)
+            {
+                std::size_t a{envelope[envelope.size() - 2]};
+                std::size_t b{envelope.back()};
+                // b is dominated if the intersection of a and i is left of that of a and b.
+                if ((offsets[i] - offsets[a]) * (slopes[b] - slopes[a]) <=
+                    (offsets[b] - offsets[a]) * (slopes[i] - slopes[a]))
+                {
+                    envelope.pop_back();
+                }
+                else
+                {
+                    break;
+                }
+            }
+            envelope.push_back(i);
+        }
+
+        return params;
+    }
+
+} // End of namespace stcp
+#endif
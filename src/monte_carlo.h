@@ -0,0 +1,245 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "stcp_interface.h"
+#include "worker_pool.h"
+
+namespace stcp
+{
+    // Philox4x32-10 counter-based generator (Salmon et al., 2011).
+    // A block of four 32-bit words is a pure function of the counter and the key,
+    // so any part of any stream can be generated without generating the preceding ones.
+    class Philox4x32
+    {
+    public:
+        using Block = std::array<std::uint32_t, 4>;
+
+        static Block generate(Block counter, std::uint32_t key0, std::uint32_t key1)
+        {
+            for (int round = 0; round < 10; round++)
+            {
+                if (round > 0)
+                {
+                    key0 += 0x9E3779B9u;
+                    key1 += 0xBB67AE85u;
+                }
+                const std::uint64_t product0{static_cast<std::uint64_t>(0xD2511F53u) * counter[0]};
+                const std::uint64_t product1{static_cast<std::uint64_t>(0xCD9E8D57u) * counter[2]};
+                counter = Block{static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key0,
+                                static_cast<std::uint32_t>(product1),
+                                static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key1,
+                                static_cast<std::uint32_t>(product0)};
+            }
+            return counter;
+        }
+    };
+
+    // Random numbers of one replicate. The i-th block of the replicate r under a seed
+    // is Philox4x32 of the counter (i, r) keyed by the seed, so each replicate has
+    // its own stream regardless of which thread runs it and in which order.
+    class ReplicateRng
+    {
+    public:
+        ReplicateRng(const std::uint64_t &seed, const std::uint64_t &replicate)
+            : m_key0{static_cast<std::uint32_t>(seed)},
+              m_key1{static_cast<std::uint32_t>(seed >> 32)},
+              m_replicate{replicate}
+        {
+        }
+
+        // Uniform on (0, 1) with 53 random bits.
+        double uniform()
+        {
+            if (m_next_word == 4)
+            {
+                m_block = Philox4x32::generate(
+                    Philox4x32::Block{static_cast<std::uint32_t>(m_block_index),
+                                      static_cast<std::uint32_t>(m_block_index >> 32),
+                                      static_cast<std::uint32_t>(m_replicate),
+                                      static_cast<std::uint32_t>(m_replicate >> 32)},
+                    m_key0, m_key1);
+                m_block_index++;
+                m_next_word = 0;
+            }
+            const std::uint64_t bits{(static_cast<std::uint64_t>(m_block[m_next_word]) << 21) ^
+                                     (m_block[m_next_word + 1] >> 11)};
+            m_next_word += 2;
+            return (static_cast<double>(bits) + 0.5) * 1.1102230246251565e-16; // 2^-53
+        }
+        // Standard normal by the Box-Muller transform, which gives a pair of
+        // independent values; the second one is returned by the next call.
+        double normal()
+        {
+            if (m_has_spare_normal)
+            {
+                m_has_spare_normal = false;
+                return m_spare_normal;
+            }
+            const double radius{std::sqrt(-2.0 * log(uniform()))};
+            const double angle{6.283185307179586 * uniform()};
+            m_spare_normal = radius * std::sin(angle);
+            m_has_spare_normal = true;
+            return radius * std::cos(angle);
+        }
+        // Gamma(shape, 1) by Marsaglia and Tsang (2000), with the boost
+        // Gamma(shape + 1) * U^(1 / shape) for shape < 1.
+        double gamma(const double &shape)
+        {
+            if (shape < 1.0)
+            {
+                return gamma(shape + 1.0) * std::pow(uniform(), 1.0 / shape);
+            }
+            const double d{shape - 1.0 / 3.0};
+            const double c{1.0 / std::sqrt(9.0 * d)};
+            while (true)
+            {
+                const double z{normal()};
+                const double v_root{1.0 + c * z};
+                if (v_root <= 0.0)
+                {
+                    continue;
+                }
+                const double v{v_root * v_root * v_root};
+                if (log(uniform()) < 0.5 * z * z + d - d * v + d * log(v))
+                {
+                    return d * v;
+                }
+            }
+        }
+
+    private:
+        std::uint32_t m_key0;
+        std::uint32_t m_key1;
+        std::uint64_t m_replicate;
+        std::uint64_t m_block_index{0};
+        Philox4x32::Block m_block{};
+        int m_next_word{4};
+        double m_spare_normal{0.0};
+        bool m_has_spare_normal{false};
+    };
+
+    // Distribution of simulated observations.
+    // * Normal: params = (mean, sd)
+    // * Ber: params = (p), observations in {0, 1}
+    // * Beta: params = (shape1, shape2), observations in [0, 1] for bounded detectors
+    class SampleGenerator
+    {
+    public:
+        SampleGenerator(const std::string &family, const std::vector<double> &params)
+            : m_param1{params.empty() ? 0.0 : params[0]},
+              m_param2{params.size() < 2 ? 0.0 : params[1]}
+        {
+            if (family == "Normal")
+            {
+                m_family = Family::Normal;
+                if (params.size() != 2 || !(m_param2 >= 0.0) || !std::isfinite(m_param1))
+                {
+                    throw std::runtime_error("Normal samples need a finite mean and a non-negative sd.");
+                }
+            }
+            else if (family == "Ber")
+            {
+                m_family = Family::Ber;
+                if (params.size() != 1 || !(m_param1 >= 0.0 && m_param1 <= 1.0))
+                {
+                    throw std::runtime_error("Ber samples need a probability p in [0, 1].");
+                }
+            }
+            else if (family == "Beta")
+            {
+                m_family = Family::Beta;
+                if (params.size() != 2 || !(m_param1 > 0.0) || !(m_param2 > 0.0))
+                {
+                    throw std::runtime_error("Beta samples need strictly positive shape1 and shape2.");
+                }
+            }
+            else
+            {
+                throw std::runtime_error("Unsupported family of samples. Use Normal, Ber or Beta.");
+            }
+        }
+
+        double draw(ReplicateRng &rng) const
+        {
+            switch (m_family)
+            {
+            case Family::Normal:
+                return m_param1 + m_param2 * rng.normal();
+            case Family::Ber:
+                return rng.uniform() < m_param1 ? 1.0 : 0.0;
+            default:
+            {
+                const double g1{rng.gamma(m_param1)};
+                return g1 / (g1 + rng.gamma(m_param2));
+            }
+            }
+        }
+
+    private:
+        enum class Family
+        {
+            Normal,
+            Ber,
+            Beta
+        };
+        Family m_family{Family::Normal};
+        double m_param1;
+        double m_param2;
+    };
+
+    // Tasks per thread of a simulation. Run lengths vary a lot across replicates,
+    // so smaller tasks let idle threads steal the remaining ones.
+    constexpr std::size_t kSimulationTasksPerThread{8};
+
+    // Stopped times of num_replicates independent runs of copies of detector,
+    // each reset to its initial state. Observations at times t <= change_point are drawn
+    // from pre and later ones from post, one at a time, so no series is materialized.
+    // A run ends at its stopped time or at max_time, in which case kPosInf is returned.
+    //
+    // D is a Stcp class with reset(), updateLogValue(), isStopped() and getStoppedTime().
+    // The replicate r uses ReplicateRng(seed, r), so the results do not depend on num_threads.
+    template <typename D>
+    inline std::vector<double> simulateStoppedTimes(const D &detector,
+                                                    const SampleGenerator &pre,
+                                                    const SampleGenerator &post,
+                                                    const double &change_point,
+                                                    const double &max_time,
+                                                    const std::size_t &num_replicates,
+                                                    const std::uint64_t &seed,
+                                                    const int &num_threads)
+    {
+        std::vector<double> stopped_times(num_replicates);
+        if (num_replicates == 0)
+        {
+            return stopped_times;
+        }
+        WorkerPool pool(num_threads);
+        const std::size_t num_tasks{
+            std::min(num_replicates, static_cast<std::size_t>(num_threads) * kSimulationTasksPerThread)};
+        pool.run(num_tasks, [&](std::size_t task_id)
+                 {
+                     // Copies share read-only parameters only, so they can be made concurrently.
+                     D replica{detector};
+                     const std::size_t begin{task_id * num_replicates / num_tasks};
+                     const std::size_t end{(task_id + 1) * num_replicates / num_tasks};
+                     for (std::size_t r = begin; r < end; r++)
+                     {
+                         replica.reset();
+                         ReplicateRng rng(seed, r);
+                         double t{0.0};
+                         while (t < max_time && !replica.isStopped())
+                         {
+                             t += 1.0;
+                             replica.updateLogValue(t <= change_point ? pre.draw(rng) : post.draw(rng));
+                         }
+                         stopped_times[r] = replica.isStopped() ? replica.getStoppedTime() : kPosInf;
+                     } });
+        return stopped_times;
+    }
+} // End of namespace stcp
+#endif
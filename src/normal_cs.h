@@ -0,0 +1,158 @@
+#ifndef NORMAL_CS_H
+#define NORMAL_CS_H
+
+#include <algorithm>
+#include <numeric>
+
+#include "stcp_interface.h"
+#include "worker_pool.h"
+
+namespace stcp
+{
+    // Widths of the confidence sequence of NormalCS (R/normal_cs.R) for many sample sizes at once.
+    // The ST mixture of Normal e-values with m_pre = 0 and sig = 1 has the closed-form log value
+    //   f_n(s) = log(sum_i w_i exp(n * (b_i * s - lambda_i^2 / 2)))
+    // at the distance s between the sample mean and the boundary of the interval after n samples,
+    // where b_i = lambda_i for the greater alternative and -lambda_i otherwise.
+    // The width at n is the root of f_n(s) = threshold, which is unique on s > 0 since
+    // f_n is convex with f_n(0) < 0 < threshold.
+    class NormalCSWidthSolver
+    {
+    public:
+        // Sample sizes per task of computeWidths. Each task warm-starts along its run
+        // of sorted sample sizes, so tasks should not be too short. The runs do not depend on
+        // the number of threads, so neither do the widths.
+        static constexpr std::size_t kSampleSizesPerTask{256};
+
+        NormalCSWidthSolver(const std::vector<double> &weights,
+                            const std::vector<double> &lambdas,
+                            const double &threshold,
+                            const bool &is_greater)
+            : m_threshold{threshold}
+        {
+            if (weights.size() != lambdas.size() || weights.empty())
+            {
+                throw std::runtime_error("Lengths of weights and lambdas must be the same and positive.");
+            }
+            for (std::size_t i = 0; i < weights.size(); i++)
+            {
+                m_log_weights.push_back(log(weights[i]));
+                m_slopes.push_back(is_greater ? lambdas[i] : -lambdas[i]);
+                m_half_squared_lambdas.push_back(lambdas[i] * lambdas[i] / 2.0);
+            }
+        }
+
+        // Width at n by Newton's method from initial_width, safeguarded by bisection
+        // within the bracket of the root found so far.
+        double computeWidth(const double &n, const double &initial_width) const
+        {
+            double lower{0.0};
+            double upper{kPosInf};
+            double s{initial_width > 0.0 ? initial_width : chernoffWidth(n)};
+            for (int iter = 0; iter < kMaxIter; iter++)
+            {
+                double gap;
+                double slope;
+                evaluate(n, s, gap, slope);
+                if (gap == 0.0)
+                {
+                    return s;
+                }
+                if (gap < 0.0)
+                {
+                    lower = s;
+                }
+                else
+                {
+                    upper = s;
+                }
+                double next{slope > 0.0 ? s - gap / slope : kNegInf};
+                if (std::abs(next - s) <= kRelTol * s)
+                {
+                    return next;
+                }
+                if (!(next > lower && next < upper))
+                {
+                    // Double s until the root is bracketed, then bisect.
+                    next = std::isinf(upper) ? 2.0 * std::max(s, chernoffWidth(n)) : (lower + upper) / 2.0;
+                    if (upper - lower <= kRelTol * upper)
+                    {
+                        return next;
+                    }
+                }
+                s = next;
+            }
+            return s;
+        }
+
+        // Widths at all ns. The sample sizes are solved in increasing order, each one starting
+        // from the width of its predecessor scaled by sqrt(n_prev / n), and contiguous runs of
+        // the sorted sample sizes are solved in parallel.
+        std::vector<double> computeWidths(const std::vector<double> &ns, const int &num_threads) const
+        {
+            for (auto &n : ns)
+            {
+                if (!(n > 0.0) || std::isinf(n))
+                {
+                    throw std::runtime_error("Sample sizes must be positive and finite.");
+                }
+            }
+            std::vector<std::size_t> order(ns.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&ns](const std::size_t &i, const std::size_t &j)
+                      { return ns[i] < ns[j]; });
+
+            std::vector<double> widths(ns.size());
+            WorkerPool pool(num_threads);
+            const std::size_t num_tasks{(ns.size() + kSampleSizesPerTask - 1) / kSampleSizesPerTask};
+            pool.run(num_tasks, [&](std::size_t task_id)
+                     {
+                         const std::size_t begin{task_id * kSampleSizesPerTask};
+                         const std::size_t end{std::min(begin + kSampleSizesPerTask, ns.size())};
+                         double prev_n{0.0};
+                         double prev_width{0.0};
+                         for (std::size_t j = begin; j < end; j++)
+                         {
+                             const double n{ns[order[j]]};
+                             const double guess{prev_width > 0.0 ? prev_width * std::sqrt(prev_n / n) : 0.0};
+                             prev_width = computeWidth(n, guess);
+                             prev_n = n;
+                             widths[order[j]] = prev_width;
+                         } });
+            return widths;
+        }
+
+    private:
+        static constexpr int kMaxIter{200};
+        static constexpr double kRelTol{1e-13};
+
+        std::vector<double> m_log_weights;
+        std::vector<double> m_slopes;
+        std::vector<double> m_half_squared_lambdas;
+        double m_threshold;
+
+        double chernoffWidth(const double &n) const { return std::sqrt(2.0 * m_threshold / n); }
+
+        // gap = f_n(s) - threshold and slope = f_n'(s).
+        void evaluate(const double &n, const double &s, double &gap, double &slope) const
+        {
+            const std::size_t k{m_log_weights.size()};
+            double max_term{kNegInf};
+            for (std::size_t i = 0; i < k; i++)
+            {
+                max_term = std::max(max_term, m_log_weights[i] + n * (m_slopes[i] * s - m_half_squared_lambdas[i]));
+            }
+            double sum_exp{0.0};
+            double sum_exp_slope{0.0};
+            for (std::size_t i = 0; i < k; i++)
+            {
+                const double e{exp(m_log_weights[i] + n * (m_slopes[i] * s - m_half_squared_lambdas[i]) - max_term)};
+                sum_exp += e;
+                sum_exp_slope += e * m_slopes[i];
+            }
+            gap = max_term + log(sum_exp) - m_threshold;
+            slope = n * sum_exp_slope / sum_exp;
+        }
+    };
+} // End of namespace stcp
+#endif
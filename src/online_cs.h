@@ -0,0 +1,327 @@
+#ifndef ONLINE_CS_H
+#define ONLINE_CS_H
+
+#include "stcp_interface.h"
+
+namespace stcp
+{
+    // Families of OnlineCS. logValue is the log of the exponential baseline with parameter lambda
+    // at the null mean m after n observations summing to sum, and logValueDiff is its derivative in m.
+    // coef = getCoef(lambda) is computed once per component. logValue is convex in m,
+    // so the set of means not rejected by a mixture of them is an interval.
+
+    // (sub-)Gaussian observations with the scale sig, the same baseline as Normal.
+    class NormalCSFamily
+    {
+    public:
+        explicit NormalCSFamily(const double &sig = 1.0)
+            : m_sig{sig}
+        {
+            if (sig <= 0)
+            {
+                throw std::runtime_error("sig must be strictly positive.");
+            }
+        }
+
+        double getLowerLimit() const { return kNegInf; }
+        double getUpperLimit() const { return kPosInf; }
+        double getScale() const { return m_sig; }
+        double transformInput(const double &x) const { return x; }
+
+        // psi(lambda) = lambda^2 * sig^2 / 2
+        double getCoef(const double &lambda) const { return lambda * lambda * m_sig * m_sig * 0.5; }
+        double logValue(const double &lambda, const double &coef, const double &sum, const double &n, const double &m) const
+        {
+            return lambda * (sum - n * m) - n * coef;
+        }
+        double logValueDiff(const double &lambda, const double &, const double &n, const double &) const
+        {
+            return -n * lambda;
+        }
+
+    protected:
+        double m_sig;
+    };
+
+    // Binary observations with the exact Bernoulli baseline of Ber,
+    // lambda * x - log(1 - m + m * exp(lambda)), at every null mean m in [0, 1].
+    class BerCSFamily
+    {
+    public:
+        double getLowerLimit() const { return 0.0; }
+        double getUpperLimit() const { return 1.0; }
+        double getScale() const { return 0.5; }
+        double transformInput(const double &x) const
+        {
+            if (std::abs(x) < kEps)
+            {
+                return 0.0;
+            }
+            else if (std::abs(x - 1.0) < kEps)
+            {
+                return 1.0;
+            }
+            else
+            {
+                throw std::runtime_error("Input must be either 0.0 or 1.0 or false or true.");
+            }
+        }
+
+        // exp(lambda) - 1
+        double getCoef(const double &lambda) const { return std::expm1(lambda); }
+        double logValue(const double &lambda, const double &coef, const double &sum, const double &n, const double &m) const
+        {
+            return lambda * sum - n * std::log1p(m * coef);
+        }
+        double logValueDiff(const double &, const double &coef, const double &n, const double &m) const
+        {
+            return -n * coef / (1.0 + m * coef);
+        }
+    };
+
+    // Observations in [0, 1], which are sub-Gaussian with sig = 1/2 by Hoeffding's lemma.
+    // The baseline of Bounded depends on every observation through x / m, so it has no
+    // sufficient statistics to track intervals in O(1) per observation.
+    class BoundedCSFamily : public NormalCSFamily
+    {
+    public:
+        BoundedCSFamily() : NormalCSFamily(0.5) {}
+
+        double getLowerLimit() const { return 0.0; }
+        double getUpperLimit() const { return 1.0; }
+        double transformInput(const double &x) const
+        {
+            if (x < 0.0 || x > 1.0)
+            {
+                throw std::runtime_error("Input must be in [0, 1].");
+            }
+            return x;
+        }
+    };
+
+    // Two-sided confidence sequence for the mean tracked online.
+    // Components with lambda > 0 grow as m decreases and bound the mean from below, and
+    // components with lambda < 0 bound it from above. An endpoint without any such component
+    // stays at the limit of the mean space.
+    // The interval after n observations is the set of null means m at which the mixture
+    //   log(sum_i w_i exp(logValue(lambda_i, sum, n, m)))
+    // is not above the threshold, i.e. the means not rejected by the ST mixture of F.
+    // Only the sum and the number of observations are kept, and each endpoint is updated
+    // by a few Newton steps from its previous value, so an update costs O(number of components)
+    // regardless of n instead of a fresh root search.
+    template <typename F>
+    class OnlineCS
+    {
+    public:
+        OnlineCS(const std::vector<double> &weights,
+                 const std::vector<double> &lambdas,
+                 const double &threshold)
+            : OnlineCS(weights, lambdas, threshold, F{})
+        {
+        }
+        OnlineCS(const std::vector<double> &weights,
+                 const std::vector<double> &lambdas,
+                 const double &threshold,
+                 const F &family)
+            : m_lambdas{lambdas}, m_threshold{threshold}, m_family{family}
+        {
+            if (weights.size() != lambdas.size() || weights.empty())
+            {
+                throw std::runtime_error("Lengths of weights and lambdas must be the same and positive.");
+            }
+            if (!(threshold > 0.0))
+            {
+                throw std::runtime_error("Threshold must be strictly positive.");
+            }
+            for (std::size_t i = 0; i < weights.size(); i++)
+            {
+                if (!(weights[i] > 0.0))
+                {
+                    throw std::runtime_error("Weights must be strictly positive.");
+                }
+                m_log_weights.push_back(log(weights[i]));
+                m_coefs.push_back(m_family.getCoef(lambdas[i]));
+                m_has_lower_bound = m_has_lower_bound || lambdas[i] > 0.0;
+                m_has_upper_bound = m_has_upper_bound || lambdas[i] < 0.0;
+            }
+            m_terms.resize(weights.size());
+            reset();
+        }
+
+        double getThreshold() { return m_threshold; }
+        double getTime() { return m_n; }
+        double getMean() { return m_n > 0.0 ? m_sum / m_n : 0.0; }
+        double getLower() { return m_lower; }
+        double getUpper() { return m_upper; }
+        std::vector<double> getInterval() { return std::vector<double>{m_lower, m_upper}; }
+
+        void reset()
+        {
+            m_sum = 0.0;
+            m_n = 0.0;
+            m_lower = m_family.getLowerLimit();
+            m_upper = m_family.getUpperLimit();
+        }
+
+        void updateInterval(const double &x)
+        {
+            addObservation(m_family.transformInput(x));
+        }
+        // The whole vector is checked before any update.
+        void updateIntervals(const std::vector<double> &xs)
+        {
+            for (auto &x : xs)
+            {
+                m_family.transformInput(x);
+            }
+            for (auto &x : xs)
+            {
+                addObservation(m_family.transformInput(x));
+            }
+        }
+        // Intervals after each observation, all lower endpoints followed by all upper ones.
+        std::vector<double> updateAndReturnIntervals(const std::vector<double> &xs)
+        {
+            for (auto &x : xs)
+            {
+                m_family.transformInput(x);
+            }
+            std::vector<double> intervals(2 * xs.size());
+            for (std::size_t i = 0; i < xs.size(); i++)
+            {
+                addObservation(m_family.transformInput(xs[i]));
+                intervals[i] = m_lower;
+                intervals[xs.size() + i] = m_upper;
+            }
+            return intervals;
+        }
+
+    protected:
+        static constexpr int kMaxIter{200};
+        static constexpr double kRelTol{1e-13};
+
+        std::vector<double> m_log_weights;
+        std::vector<double> m_lambdas;
+        std::vector<double> m_coefs;
+        double m_threshold;
+        F m_family;
+        bool m_has_lower_bound{false};
+        bool m_has_upper_bound{false};
+        // Preallocated buffer of log(weight) + log value of each component.
+        std::vector<double> m_terms;
+
+        double m_sum{0.0};
+        double m_n{0.0};
+        double m_lower{kNegInf};
+        double m_upper{kPosInf};
+
+        void addObservation(const double &x)
+        {
+            m_sum += x;
+            m_n += 1.0;
+            const double mean{m_sum / m_n};
+            // Previous endpoints are the starting points, so a step takes a few Newton iterations.
+            m_upper = m_has_upper_bound
+                          ? mean + solveDistance(mean, 1.0, m_upper - mean, m_family.getUpperLimit() - mean)
+                          : m_family.getUpperLimit();
+            m_lower = m_has_lower_bound
+                          ? mean - solveDistance(mean, -1.0, mean - m_lower, mean - m_family.getLowerLimit())
+                          : m_family.getLowerLimit();
+        }
+
+        // gap = mixture log value - threshold at m, and slope = its derivative in m.
+        void evaluate(const double &m, double &gap, double &slope)
+        {
+            const std::size_t k{m_log_weights.size()};
+            double max_term{kNegInf};
+            for (std::size_t i = 0; i < k; i++)
+            {
+                m_terms[i] = m_log_weights[i] + m_family.logValue(m_lambdas[i], m_coefs[i], m_sum, m_n, m);
+                max_term = std::max(max_term, m_terms[i]);
+            }
+            if (std::isinf(max_term))
+            {
+                gap = max_term;
+                slope = std::numeric_limits<double>::quiet_NaN();
+                return;
+            }
+            double sum_exp{0.0};
+            double sum_exp_diff{0.0};
+            for (std::size_t i = 0; i < k; i++)
+            {
+                const double e{exp(m_terms[i] - max_term)};
+                sum_exp += e;
+                sum_exp_diff += e * m_family.logValueDiff(m_lambdas[i], m_coefs[i], m_n, m);
+            }
+            gap = max_term + log(sum_exp) - m_threshold;
+            slope = sum_exp_diff / sum_exp;
+        }
+
+        // Distance s >= 0 from the mean to the endpoint in the direction dir (+1 or -1),
+        // i.e. the root of gap(mean + dir * s), which is increasing in s at the root.
+        // The mean is always inside the interval since every baseline is at most 1 there,
+        // and the distance is capped by max_distance to the limit of the mean space.
+        // Newton's method is safeguarded by the bracket [lower, upper] found so far.
+        double solveDistance(const double &mean, const double &dir, const double &initial, const double &max_distance)
+        {
+            if (!(max_distance > 0.0))
+            {
+                return 0.0;
+            }
+            const double scale{m_family.getScale() * std::sqrt(2.0 * m_threshold / m_n)};
+            double lower{0.0};
+            double upper{max_distance};
+            bool is_upper_bracket{false};
+            double s{initial > 0.0 && initial < max_distance ? initial : std::min(scale, max_distance)};
+            for (int iter = 0; iter < kMaxIter; iter++)
+            {
+                double gap;
+                double slope;
+                evaluate(mean + dir * s, gap, slope);
+                slope *= dir;
+                if (gap == 0.0)
+                {
+                    return s;
+                }
+                if (gap < 0.0)
+                {
+                    lower = s;
+                    if (s == max_distance)
+                    {
+                        // No mean up to the limit is rejected.
+                        return s;
+                    }
+                }
+                else
+                {
+                    upper = s;
+                    is_upper_bracket = true;
+                }
+                double next{slope > 0.0 ? s - gap / slope : kNegInf};
+                if (std::abs(next - s) <= kRelTol * s)
+                {
+                    return next;
+                }
+                if (!(next > lower && next < upper))
+                {
+                    if (is_upper_bracket)
+                    {
+                        next = (lower + upper) / 2.0;
+                        if (upper - lower <= kRelTol * upper)
+                        {
+                            return next;
+                        }
+                    }
+                    else
+                    {
+                        // Expand until the root is bracketed, trying the limit itself last.
+                        next = std::min(2.0 * std::max(s, scale), max_distance);
+                    }
+                }
+                s = next;
+            }
+            return s;
+        }
+    };
+} // End of namespace stcp
+#endif
@@ -0,0 +1,65 @@
+// online_cs_export.cpp
+
+#include "stcp_export.h"
+
+#include <Rcpp.h>
+
+RCPP_MODULE(OnlineCSNormalEx) {
+  using namespace stcp;
+  using F = NormalCSFamily;
+
+  Rcpp::class_<OnlineCS<F>>("OnlineCSNormal")
+    .constructor<std::vector<double>, std::vector<double>, double>()
+
+    .method("getThreshold", &OnlineCS<F>::getThreshold)
+    .method("getTime", &OnlineCS<F>::getTime)
+    .method("getMean", &OnlineCS<F>::getMean)
+    .method("getLower", &OnlineCS<F>::getLower)
+    .method("getUpper", &OnlineCS<F>::getUpper)
+    .method("getInterval", &OnlineCS<F>::getInterval)
+    .method("reset", &OnlineCS<F>::reset)
+    .method("updateInterval", &OnlineCS<F>::updateInterval)
+    .method("updateIntervals", &OnlineCS<F>::updateIntervals)
+    .method("updateAndReturnIntervals", &OnlineCS<F>::updateAndReturnIntervals)
+    ;
+}
+
+RCPP_MODULE(OnlineCSBerEx) {
+  using namespace stcp;
+  using F = BerCSFamily;
+
+  Rcpp::class_<OnlineCS<F>>("OnlineCSBer")
+    .constructor<std::vector<double>, std::vector<double>, double>()
+
+    .method("getThreshold", &OnlineCS<F>::getThreshold)
+    .method("getTime", &OnlineCS<F>::getTime)
+    .method("getMean", &OnlineCS<F>::getMean)
+    .method("getLower", &OnlineCS<F>::getLower)
+    .method("getUpper", &OnlineCS<F>::getUpper)
+    .method("getInterval", &OnlineCS<F>::getInterval)
+    .method("reset", &OnlineCS<F>::reset)
+    .method("updateInterval", &OnlineCS<F>::updateInterval)
+    .method("updateIntervals", &OnlineCS<F>::updateIntervals)
+    .method("updateAndReturnIntervals", &OnlineCS<F>::updateAndReturnIntervals)
+    ;
+}
+
+RCPP_MODULE(OnlineCSBoundedEx) {
+  using namespace stcp;
+  using F = BoundedCSFamily;
+
+  Rcpp::class_<OnlineCS<F>>("OnlineCSBounded")
+    .constructor<std::vector<double>, std::vector<double>, double>()
+
+    .method("getThreshold", &OnlineCS<F>::getThreshold)
+    .method("getTime", &OnlineCS<F>::getTime)
+    .method("getMean", &OnlineCS<F>::getMean)
+    .method("getLower", &OnlineCS<F>::getLower)
+    .method("getUpper", &OnlineCS<F>::getUpper)
+    .method("getInterval", &OnlineCS<F>::getInterval)
+    .method("reset", &OnlineCS<F>::reset)
+    .method("updateInterval", &OnlineCS<F>::updateInterval)
+    .method("updateIntervals", &OnlineCS<F>::updateIntervals)
+    .method("updateAndReturnIntervals", &OnlineCS<F>::updateAndReturnIntervals)
+    ;
+}
@@ -0,0 +1,367 @@
+#ifndef R_VECTOR_SPAN_H
+#define R_VECTOR_SPAN_H
+
+#include <Rcpp.h>
+
+#include "stcp_export.h"
+#include "mapped_stream.h"
+
+namespace stcp
+{
+    // Inputs read at once from an R vector without a data pointer.
+    constexpr R_xlen_t kRVectorChunkSize{1 << 14};
+
+    // Read-only view of a numeric R vector that does not copy it.
+    // Double vectors with a data pointer, including ALTREP vectors that expose one
+    // (e.g. memory-mapped ones), are read in place. Other ALTREP vectors
+    // (e.g. compact sequences) are read by REAL_GET_REGION in chunks into a fixed buffer,
+    // so they are never materialized. Integer and logical vectors are coerced to double,
+    // as Rcpp does for std::vector<double> arguments.
+    //
+    // Rcpp::NumericVector is not used since it takes the data pointer on construction,
+    // which materializes ALTREP vectors.
+    class RVectorSpan
+    {
+    public:
+        explicit RVectorSpan(SEXP xs)
+            : m_xs{TYPEOF(xs) == REALSXP ? xs : Rf_coerceVector(checkNumericType(xs), REALSXP)}
+        {
+            if (ALTREP(m_xs))
+            {
+                m_data = static_cast<const double *>(DATAPTR_OR_NULL(m_xs));
+            }
+            else
+            {
+                m_data = REAL(m_xs);
+            }
+        }
+
+        std::size_t size() const { return static_cast<std::size_t>(Rf_xlength(m_xs)); }
+        bool isContiguous() const { return m_data != nullptr; }
+
+        // Pointer to len inputs from start. Without a data pointer, len must not exceed
+        // kRVectorChunkSize, and the pointer is valid until the next call.
+        const double *read(const std::size_t &start, const std::size_t &len)
+        {
+            if (m_data)
+            {
+                return m_data + start;
+            }
+            m_buffer.resize(static_cast<std::size_t>(kRVectorChunkSize));
+            REAL_GET_REGION(m_xs, static_cast<R_xlen_t>(start), static_cast<R_xlen_t>(len), m_buffer.data());
+            return m_buffer.data();
+        }
+
+    private:
+        // Other types are rejected by a C++ exception before Rf_coerceVector, which would
+        // raise an R error through C++ frames or turn strings into NA.
+        static SEXP checkNumericType(SEXP xs)
+        {
+            if (TYPEOF(xs) != INTSXP && TYPEOF(xs) != LGLSXP)
+            {
+                throw std::runtime_error("Input must be a numeric or logical vector.");
+            }
+            return xs;
+        }
+
+        Rcpp::RObject m_xs; // Protects the coerced copy, if any.
+        const double *m_data{nullptr};
+        std::vector<double> m_buffer;
+    };
+
+    // Calls f(start, len) on consecutive chunks of n inputs until it returns false.
+    // Contiguous inputs are passed as a single chunk.
+    template <typename F>
+    inline void forEachRVectorChunk(const std::size_t &n, const bool &is_contiguous, const F &f)
+    {
+        const std::size_t chunk_size{is_contiguous ? n : static_cast<std::size_t>(kRVectorChunkSize)};
+        for (std::size_t start = 0; start < n; start += chunk_size)
+        {
+            if (!f(start, std::min(chunk_size, n - start)))
+            {
+                break;
+            }
+        }
+    }
+
+    // Checks all chunks before the first update, as the vector methods do, when
+    // the inputs are not passed as a single span.
+    inline void checkRVectorSpan(IStcp *stcp, RVectorSpan &xs)
+    {
+        if (xs.isContiguous() || !stcp->hasInputChecks())
+        {
+            return;
+        }
+        forEachRVectorChunk(xs.size(), false, [&](const std::size_t &start, const std::size_t &len)
+                            {
+                                stcp->checkInputs(xs.read(start, len), len);
+                                return true; });
+    }
+
+    inline void checkSameLength(const RVectorSpan &x_bars, const RVectorSpan &ns)
+    {
+        if (x_bars.size() != ns.size())
+        {
+            throw std::runtime_error("x_bars and ns do not have the same length.");
+        }
+    }
+
+    // Pointer to out[offset] of a double vector allocated in R to write n log values.
+    inline double *getHistoryOutput(SEXP out, const double &offset, const std::size_t &n)
+    {
+        if (TYPEOF(out) != REALSXP || ALTREP(out))
+        {
+            throw std::runtime_error("out must be a double vector allocated in R, e.g. by numeric().");
+        }
+        if (!(offset >= 0.0) || offset != std::floor(offset) ||
+            offset + static_cast<double>(n) > static_cast<double>(Rf_xlength(out)))
+        {
+            throw std::runtime_error("offset must be a non-negative integer with offset + length(xs) <= length(out).");
+        }
+        return REAL(out) + static_cast<std::size_t>(offset);
+    }
+
+    inline void writeHistories(IStcp *stcp, RVectorSpan &xs, double *log_values)
+    {
+        checkRVectorSpan(stcp, xs);
+        forEachRVectorChunk(xs.size(), xs.isContiguous(), [&](const std::size_t &start, const std::size_t &len)
+                            {
+                                stcp->updateAndReturnHistoriesBySpan(xs.read(start, len), len, log_values + start);
+                                return true; });
+    }
+    inline void writeHistoriesByAvgs(IStcp *stcp, RVectorSpan &x_bars, RVectorSpan &ns, double *log_values)
+    {
+        forEachRVectorChunk(x_bars.size(), x_bars.isContiguous() && ns.isContiguous(),
+                            [&](const std::size_t &start, const std::size_t &len)
+                            {
+                                stcp->updateAndReturnHistoriesByAvgSpans(x_bars.read(start, len), ns.read(start, len), len, log_values + start);
+                                return true; });
+    }
+
+    // Methods of Stcp classes exported to R, which read R vectors by RVectorSpan
+    // instead of copying them into std::vector<double>.
+    template <typename S>
+    inline void updateLogValuesFromR(S *stcp, SEXP xs_sexp)
+    {
+        RVectorSpan xs(xs_sexp);
+        checkRVectorSpan(stcp, xs);
+        forEachRVectorChunk(xs.size(), xs.isContiguous(), [&](const std::size_t &start, const std::size_t &len)
+                            {
+                                stcp->updateLogValuesBySpan(xs.read(start, len), len);
+                                return true; });
+    }
+    template <typename S>
+    inline void updateLogValuesUntilStopFromR(S *stcp, SEXP xs_sexp)
+    {
+        RVectorSpan xs(xs_sexp);
+        checkRVectorSpan(stcp, xs);
+        forEachRVectorChunk(xs.size(), xs.isContiguous(), [&](const std::size_t &start, const std::size_t &len)
+                            {
+                                stcp->updateLogValuesUntilStopBySpan(xs.read(start, len), len);
+                                return !stcp->isStopped(); });
+    }
+    // Same as updateLogValuesFromR, and returns the alarm times of auto-restart monitoring
+    // recorded by this call.
+    template <typename S>
+    inline std::vector<double> updateAndReturnAlarmTimesFromR(S *stcp, SEXP xs_sexp)
+    {
+        const std::size_t first_alarm{stcp->getNumAlarms()};
+        updateLogValuesFromR(stcp, xs_sexp);
+        const double *alarm_times{stcp->getAlarmTimesData()};
+        return std::vector<double>(alarm_times + first_alarm, alarm_times + stcp->getNumAlarms());
+    }
+    template <typename S>
+    inline Rcpp::NumericVector updateAndReturnHistoriesFromR(S *stcp, SEXP xs_sexp)
+    {
+        RVectorSpan xs(xs_sexp);
+        Rcpp::NumericVector log_values(Rcpp::no_init(static_cast<R_xlen_t>(xs.size())));
+        writeHistories(stcp, xs, log_values.begin());
+        return log_values;
+    }
+    // Same as above, but the log values are written into out[offset + i] of a double vector
+    // allocated by the caller, which is modified in place. Long series can thus fill
+    // one preallocated result chunk by chunk. Returns whether stcp is stopped.
+    template <typename S>
+    inline bool updateAndWriteHistoriesFromR(S *stcp, SEXP xs_sexp, SEXP out, const double &offset)
+    {
+        RVectorSpan xs(xs_sexp);
+        writeHistories(stcp, xs, getHistoryOutput(out, offset, xs.size()));
+        return stcp->isStopped();
+    }
+
+    // Summaries of the histories of xs by Stcp::updateAndSummarizeHistoriesBySpan.
+    // Inputs are checked before the first update as in writeHistories.
+    template <typename S, typename H>
+    inline void summarizeHistories(S *stcp, RVectorSpan &xs, H &summary)
+    {
+        checkRVectorSpan(stcp, xs);
+        forEachRVectorChunk(xs.size(), xs.isContiguous(), [&](const std::size_t &start, const std::size_t &len)
+                            {
+                                stcp->updateAndSummarizeHistoriesBySpan(xs.read(start, len), len, summary);
+                                return true; });
+    }
+    inline std::size_t getPositiveCount(const double &value, const char *name)
+    {
+        if (!(value >= 1.0) || value != std::floor(value) || std::isinf(value))
+        {
+            throw std::runtime_error(std::string(name) + " must be a positive integer.");
+        }
+        return static_cast<std::size_t>(value);
+    }
+    // Every k-th log value.
+    template <typename S>
+    inline std::vector<double> updateAndReturnDecimatedHistoriesFromR(S *stcp, SEXP xs_sexp, const double &k)
+    {
+        RVectorSpan xs(xs_sexp);
+        DecimatedHistory summary(getPositiveCount(k, "k"));
+        summarizeHistories(stcp, xs, summary);
+        return summary.getLogValues();
+    }
+    // Minimum, maximum and last log values of each bucket of bucket_size observations.
+    template <typename S>
+    inline Rcpp::List updateAndReturnHistoryEnvelopesFromR(S *stcp, SEXP xs_sexp, const double &bucket_size)
+    {
+        RVectorSpan xs(xs_sexp);
+        HistoryEnvelope summary(getPositiveCount(bucket_size, "bucket_size"));
+        summarizeHistories(stcp, xs, summary);
+        return Rcpp::List::create(
+            Rcpp::Named("min") = summary.getMins(),
+            Rcpp::Named("max") = summary.getMaxs(),
+            Rcpp::Named("last") = summary.getLasts());
+    }
+    // Log values not less than the threshold minus margin, and their 1-based indices in xs.
+    template <typename S>
+    inline Rcpp::List updateAndReturnNearThresholdHistoriesFromR(S *stcp, SEXP xs_sexp, const double &margin)
+    {
+        if (!(margin >= 0.0))
+        {
+            throw std::runtime_error("margin must be non-negative.");
+        }
+        RVectorSpan xs(xs_sexp);
+        NearThresholdHistory summary(stcp->getThreshold() - margin);
+        summarizeHistories(stcp, xs, summary);
+        return Rcpp::List::create(
+            Rcpp::Named("index") = summary.getIndices(),
+            Rcpp::Named("log_value") = summary.getLogValues());
+    }
+
+    template <typename S>
+    inline void updateLogValuesByAvgsFromR(S *stcp, SEXP x_bars_sexp, SEXP ns_sexp)
+    {
+        RVectorSpan x_bars(x_bars_sexp);
+        RVectorSpan ns(ns_sexp);
+        checkSameLength(x_bars, ns);
+        forEachRVectorChunk(x_bars.size(), x_bars.isContiguous() && ns.isContiguous(),
+                            [&](const std::size_t &start, const std::size_t &len)
+                            {
+                                stcp->updateLogValuesByAvgSpans(x_bars.read(start, len), ns.read(start, len), len);
+                                return true; });
+    }
+    template <typename S>
+    inline void updateLogValuesUntilStopByAvgsFromR(S *stcp, SEXP x_bars_sexp, SEXP ns_sexp)
+    {
+        RVectorSpan x_bars(x_bars_sexp);
+        RVectorSpan ns(ns_sexp);
+        checkSameLength(x_bars, ns);
+        forEachRVectorChunk(x_bars.size(), x_bars.isContiguous() && ns.isContiguous(),
+                            [&](const std::size_t &start, const std::size_t &len)
+                            {
+                                stcp->updateLogValuesUntilStopByAvgSpans(x_bars.read(start, len), ns.read(start, len), len);
+                                return !stcp->isStopped(); });
+    }
+    template <typename S>
+    inline Rcpp::NumericVector updateAndReturnHistoriesByAvgsFromR(S *stcp, SEXP x_bars_sexp, SEXP ns_sexp)
+    {
+        RVectorSpan x_bars(x_bars_sexp);
+        RVectorSpan ns(ns_sexp);
+        checkSameLength(x_bars, ns);
+        Rcpp::NumericVector log_values(Rcpp::no_init(static_cast<R_xlen_t>(x_bars.size())));
+        writeHistoriesByAvgs(stcp, x_bars, ns, log_values.begin());
+        return log_values;
+    }
+    template <typename S>
+    inline bool updateAndWriteHistoriesByAvgsFromR(S *stcp, SEXP x_bars_sexp, SEXP ns_sexp, SEXP out, const double &offset)
+    {
+        RVectorSpan x_bars(x_bars_sexp);
+        RVectorSpan ns(ns_sexp);
+        checkSameLength(x_bars, ns);
+        writeHistoriesByAvgs(stcp, x_bars, ns, getHistoryOutput(out, offset, x_bars.size()));
+        return stcp->isStopped();
+    }
+
+    // External pointer to stcp as IStcp for the .Call entry points of stcp_call_export.cpp,
+    // which skip the method dispatch of Rcpp modules. The pointer does not own stcp,
+    // so it must be kept with the module object (see Stcp in R).
+    inline SEXP getIStcpPointerTag() { return Rf_install("stcp::IStcp"); }
+    template <typename S>
+    inline SEXP getInterfacePointerR(S *stcp)
+    {
+        return R_MakeExternalPtr(static_cast<IStcp *>(stcp), getIStcpPointerTag(), R_NilValue);
+    }
+    inline IStcp *getIStcpPointer(SEXP xptr)
+    {
+        if (TYPEOF(xptr) != EXTPTRSXP || R_ExternalPtrTag(xptr) != getIStcpPointerTag())
+        {
+            throw std::runtime_error("Not a pointer to an stcp object.");
+        }
+        IStcp *stcp{static_cast<IStcp *>(R_ExternalPtrAddr(xptr))};
+        if (!stcp)
+        {
+            // e.g. restored by readRDS.
+            throw std::runtime_error("Pointer to an stcp object is no longer valid.");
+        }
+        return stcp;
+    }
+    // Value of a numeric scalar without coercing it into a new vector.
+    inline double getScalarInput(SEXP x, const char *name)
+    {
+        if (Rf_xlength(x) != 1)
+        {
+            throw std::runtime_error(std::string(name) + " must be a single number.");
+        }
+        switch (TYPEOF(x))
+        {
+        case REALSXP:
+            return REAL_ELT(x, 0);
+        case INTSXP:
+            return INTEGER_ELT(x, 0) == NA_INTEGER ? NA_REAL : static_cast<double>(INTEGER_ELT(x, 0));
+        case LGLSXP:
+            return LOGICAL_ELT(x, 0) == NA_LOGICAL ? NA_REAL : static_cast<double>(LOGICAL_ELT(x, 0));
+        default:
+            throw std::runtime_error(std::string(name) + " must be a single number.");
+        }
+    }
+
+    // Streams a binary file of doubles (or of (x_bar, n) pairs if is_avgs) through stcp
+    // by streamMappedFile from the record offset, and returns only a summary to R:
+    // the number of records applied, the 1-based record at which stcp stopped in this call
+    // (NA if it did not), and the final state.
+    inline Rcpp::List streamFileFromR(IStcp *stcp, const std::string &path, const bool &is_avgs,
+                                      const bool &is_until_stop, const double &offset)
+    {
+        if (!(offset >= 0.0) || offset != std::floor(offset))
+        {
+            throw std::runtime_error("offset must be a non-negative integer.");
+        }
+        const MappedStreamResult result{
+            streamMappedFile(stcp, path, is_avgs, is_until_stop, static_cast<std::size_t>(offset))};
+        return Rcpp::List::create(
+            Rcpp::Named("num_records") = static_cast<double>(result.num_records),
+            Rcpp::Named("stop_offset") = result.is_newly_stopped ? static_cast<double>(result.stop_record) + 1.0 : NA_REAL,
+            Rcpp::Named("is_stopped") = stcp->isStopped(),
+            Rcpp::Named("time") = stcp->getTime(),
+            Rcpp::Named("stopped_time") = stcp->getStoppedTime(),
+            Rcpp::Named("log_value") = stcp->getLogValue());
+    }
+    template <typename S>
+    inline Rcpp::List updateLogValuesFromFileR(S *stcp, const std::string &path, const bool &is_until_stop, const double &offset)
+    {
+        return streamFileFromR(stcp, path, false, is_until_stop, offset);
+    }
+    template <typename S>
+    inline Rcpp::List updateLogValuesByAvgsFromFileR(S *stcp, const std::string &path, const bool &is_until_stop, const double &offset)
+    {
+        return streamFileFromR(stcp, path, true, is_until_stop, offset);
+    }
+} // End of namespace stcp
+#endif
@@ -0,0 +1,371 @@
+#ifndef SHARDED_STCP_BANK_H
+#define SHARDED_STCP_BANK_H
+
+#include <algorithm>
+#include <memory>
+
+#include "stcp_bank.h"
+#include "worker_pool.h"
+
+namespace stcp
+{
+    // Bank of mixture detectors whose streams are partitioned into shards
+    // updated in parallel by a fixed pool of num_threads threads.
+    // The stream s belongs to the shard s % num_shards as its local stream s / num_shards,
+    // and each shard is a StcpBank owning the state of its streams, so threads never
+    // share detector state and no lock is taken on it.
+    //
+    // A batch is checked and scattered into shard-local batches on the calling thread,
+    // keeping the order of observations of each stream, and the results equal to those of
+    // a single StcpBank regardless of the number of threads. Alarms are merged by
+    // their positions in the batch, so the returned ids are also deterministic.
+    // Worker threads run C++ code only; all conversions from and to R objects
+    // happen on the calling thread before and after a batch.
+    template <typename E>
+    class ShardedStcpBank
+    {
+        static_assert(std::is_base_of<IGeneralE, E>::value, "Type must be derived from IGeneralE class.");
+
+    public:
+        using L = typename E::BaseType;
+
+        // Shards per thread. More shards than threads let idle threads steal work
+        // when the streams of a batch are unevenly distributed.
+        static constexpr int kShardsPerThread{4};
+
+        ShardedStcpBank();
+        ShardedStcpBank(const int &num_streams,
+                        const double &threshold,
+                        const std::vector<L> &base_objs,
+                        const std::vector<double> &weights,
+                        const int &num_threads);
+
+        int getNumStreams() { return static_cast<int>(m_num_streams); }
+        double getThreshold() { return m_threshold; }
+        int getNumThreads() { return m_pool->getNumThreads(); }
+        int getNumShards() { return static_cast<int>(m_shards.size()); }
+
+        // Per-stream accessors. Stream ids are 0-based indices.
+        double getLogValue(const int &stream_id);
+        bool isStopped(const int &stream_id);
+        double getTime(const int &stream_id);
+        double getStoppedTime(const int &stream_id);
+        void reset(const int &stream_id);
+
+        std::vector<double> getLogValues();
+        std::vector<int> getStoppedIds();
+        void resetAll();
+
+        // Same as StcpBank::updateLogValues and StcpBank::updateLogValuesByAvgs.
+        std::vector<int> updateLogValues(const std::vector<int> &stream_ids,
+                                         const std::vector<double> &xs);
+        std::vector<int> updateLogValuesByAvgs(const std::vector<int> &stream_ids,
+                                               const std::vector<double> &x_bars,
+                                               const std::vector<double> &ns);
+
+        // Binary snapshot of all streams in one contiguous buffer (see checkpoint.h):
+        // the states of the streams in the order of their ids after the header.
+        // The layout does not depend on the shards, so a snapshot can be loaded by
+        // a bank of the same configuration with a different number of threads.
+        // loadState checks the whole snapshot before any stream is changed.
+        std::vector<unsigned char> saveState();
+        void loadState(const std::vector<unsigned char> &snapshot);
+        std::uint64_t getConfigHash();
+
+    protected:
+        // Aligned to a cache line so that threads updating neighbouring shards
+        // do not write to the same line.
+        struct alignas(64) Shard
+        {
+            explicit Shard(StcpBank<E> &&shard_bank) : bank{std::move(shard_bank)} {}
+
+            StcpBank<E> bank;
+            // Shard-local batch reused across batches.
+            std::vector<int> stream_ids;
+            std::vector<double> xs;
+            std::vector<double> ns;
+            // Position in the whole batch of each observation of the local batch.
+            std::vector<std::size_t> positions;
+            std::vector<std::size_t> stopped_positions;
+        };
+
+        std::size_t m_num_streams{0};
+        double m_threshold{log(1.0 / 0.05)}; // Default threshold uses alpha = 0.05.
+        L m_base_obj;
+        std::vector<Shard> m_shards;
+        std::unique_ptr<WorkerPool> m_pool;
+
+        Shard &getShard(const std::size_t &s) { return m_shards[s % m_shards.size()]; }
+        int toLocalId(const std::size_t &s) { return static_cast<int>(s / m_shards.size()); }
+        std::size_t validateStreamId(const int &stream_id);
+        void scatter(const std::vector<int> &stream_ids,
+                     const std::vector<double> &xs,
+                     const std::vector<double> *ns);
+        std::vector<int> gatherStoppedIds(const std::vector<int> &stream_ids);
+    };
+
+    // Constructors
+    template <typename E>
+    inline ShardedStcpBank<E>::ShardedStcpBank()
+        : ShardedStcpBank<E>::ShardedStcpBank(1,
+                                              log(1.0 / 0.05),
+                                              std::vector<L>(1),
+                                              std::vector<double>{1.0},
+                                              1)
+    {
+    }
+    template <typename E>
+    inline ShardedStcpBank<E>::ShardedStcpBank(const int &num_streams,
+                                               const double &threshold,
+                                               const std::vector<L> &base_objs,
+                                               const std::vector<double> &weights,
+                                               const int &num_threads)
+        : m_threshold{threshold},
+          m_pool{new WorkerPool(num_threads)}
+    {
+        if (num_streams <= 0)
+        {
+            throw std::runtime_error("Number of streams must be strictly positive.");
+        }
+        if (base_objs.empty())
+        {
+            throw std::runtime_error("Baseline objects must not be empty.");
+        }
+        m_num_streams = static_cast<std::size_t>(num_streams);
+        m_base_obj = base_objs[0];
+
+        const std::size_t num_shards{
+            num_threads == 1 ? 1 : std::min(m_num_streams, static_cast<std::size_t>(num_threads * kShardsPerThread))};
+        m_shards.reserve(num_shards);
+        for (std::size_t i = 0; i < num_shards; i++)
+        {
+            // Number of streams s < num_streams with s % num_shards == i.
+            const int num_shard_streams{static_cast<int>((m_num_streams - i + num_shards - 1) / num_shards)};
+            m_shards.emplace_back(StcpBank<E>(num_shard_streams, threshold, base_objs, weights));
+        }
+    }
+
+    // Public members
+    template <typename E>
+    inline double ShardedStcpBank<E>::getLogValue(const int &stream_id)
+    {
+        const std::size_t s{validateStreamId(stream_id)};
+        return getShard(s).bank.getLogValue(toLocalId(s));
+    }
+    template <typename E>
+    inline bool ShardedStcpBank<E>::isStopped(const int &stream_id)
+    {
+        const std::size_t s{validateStreamId(stream_id)};
+        return getShard(s).bank.isStopped(toLocalId(s));
+    }
+    template <typename E>
+    inline double ShardedStcpBank<E>::getTime(const int &stream_id)
+    {
+        const std::size_t s{validateStreamId(stream_id)};
+        return getShard(s).bank.getTime(toLocalId(s));
+    }
+    template <typename E>
+    inline double ShardedStcpBank<E>::getStoppedTime(const int &stream_id)
+    {
+        const std::size_t s{validateStreamId(stream_id)};
+        return getShard(s).bank.getStoppedTime(toLocalId(s));
+    }
+    template <typename E>
+    inline void ShardedStcpBank<E>::reset(const int &stream_id)
+    {
+        const std::size_t s{validateStreamId(stream_id)};
+        getShard(s).bank.reset(toLocalId(s));
+    }
+
+    template <typename E>
+    inline std::vector<double> ShardedStcpBank<E>::getLogValues()
+    {
+        if (m_shards.size() == 1)
+        {
+            return m_shards[0].bank.getLogValues();
+        }
+        const std::size_t num_shards{m_shards.size()};
+        std::vector<double> log_values(m_num_streams);
+        m_pool->run(num_shards, [this, &log_values, num_shards](std::size_t i)
+                    {
+                        const std::vector<double> shard_log_values{m_shards[i].bank.getLogValues()};
+                        for (std::size_t j = 0; j < shard_log_values.size(); j++)
+                        {
+                            log_values[j * num_shards + i] = shard_log_values[j];
+                        } });
+        return log_values;
+    }
+    template <typename E>
+    inline std::vector<int> ShardedStcpBank<E>::getStoppedIds()
+    {
+        std::vector<int> stopped_ids;
+        for (std::size_t s = 0; s < m_num_streams; s++)
+        {
+            if (getShard(s).bank.isStopped(toLocalId(s)))
+            {
+                stopped_ids.push_back(static_cast<int>(s));
+            }
+        }
+        return stopped_ids;
+    }
+    template <typename E>
+    inline void ShardedStcpBank<E>::resetAll()
+    {
+        for (auto &shard : m_shards)
+        {
+            shard.bank.resetAll();
+        }
+    }
+
+    template <typename E>
+    inline std::vector<unsigned char> ShardedStcpBank<E>::saveState()
+    {
+        std::vector<unsigned char> snapshot;
+        SnapshotWriter writer(snapshot);
+        writer.reserve(kSnapshotHeaderSize +
+                       m_num_streams * StcpBank<E>::getStreamStateSize(m_shards[0].bank.getNumComponents()));
+        writer.writeHeader(kBankSnapshotMagic, getConfigHash());
+        for (std::size_t s = 0; s < m_num_streams; s++)
+        {
+            getShard(s).bank.saveStreamState(toLocalId(s), writer);
+        }
+        writer.finish();
+        return snapshot;
+    }
+    template <typename E>
+    inline void ShardedStcpBank<E>::loadState(const std::vector<unsigned char> &snapshot)
+    {
+        SnapshotReader reader(snapshot.data(), snapshot.size());
+        reader.readHeader(kBankSnapshotMagic, getConfigHash());
+        reader.checkRemainingSize(m_num_streams * StcpBank<E>::getStreamStateSize(m_shards[0].bank.getNumComponents()));
+        for (std::size_t s = 0; s < m_num_streams; s++)
+        {
+            getShard(s).bank.loadStreamState(toLocalId(s), reader);
+        }
+    }
+    template <typename E>
+    inline std::uint64_t ShardedStcpBank<E>::getConfigHash()
+    {
+        ConfigHash hash;
+        hash.add(m_threshold);
+        hash.add(static_cast<std::uint64_t>(m_num_streams));
+        m_shards[0].bank.hashConfig(hash);
+        return hash.get();
+    }
+
+    template <typename E>
+    inline std::vector<int> ShardedStcpBank<E>::updateLogValues(const std::vector<int> &stream_ids,
+                                                                const std::vector<double> &xs)
+    {
+        if (m_shards.size() == 1)
+        {
+            return m_shards[0].bank.updateLogValues(stream_ids, xs);
+        }
+        if (stream_ids.size() != xs.size())
+        {
+            throw std::runtime_error("stream_ids and xs do not have the same length.");
+        }
+        // The whole batch is checked here, so that no shard is updated
+        // if another one would reject its part of the batch.
+        for (std::size_t i = 0; i < xs.size(); i++)
+        {
+            validateStreamId(stream_ids[i]);
+            m_base_obj.transformInput(xs[i]);
+        }
+        scatter(stream_ids, xs, nullptr);
+        m_pool->run(m_shards.size(), [this](std::size_t i)
+                    {
+                        Shard &shard{m_shards[i]};
+                        shard.bank.updateLogValuesAndGetStoppedPositions(shard.stream_ids,
+                                                                         shard.xs,
+                                                                         shard.stopped_positions); });
+        return gatherStoppedIds(stream_ids);
+    }
+    template <typename E>
+    inline std::vector<int> ShardedStcpBank<E>::updateLogValuesByAvgs(const std::vector<int> &stream_ids,
+                                                                      const std::vector<double> &x_bars,
+                                                                      const std::vector<double> &ns)
+    {
+        if (m_shards.size() == 1)
+        {
+            return m_shards[0].bank.updateLogValuesByAvgs(stream_ids, x_bars, ns);
+        }
+        if (stream_ids.size() != x_bars.size() || x_bars.size() != ns.size())
+        {
+            throw std::runtime_error("stream_ids, x_bars and ns do not have the same length.");
+        }
+        for (auto &stream_id : stream_ids)
+        {
+            validateStreamId(stream_id);
+        }
+        scatter(stream_ids, x_bars, &ns);
+        m_pool->run(m_shards.size(), [this](std::size_t i)
+                    {
+                        Shard &shard{m_shards[i]};
+                        shard.bank.updateLogValuesByAvgsAndGetStoppedPositions(shard.stream_ids,
+                                                                               shard.xs,
+                                                                               shard.ns,
+                                                                               shard.stopped_positions); });
+        return gatherStoppedIds(stream_ids);
+    }
+
+    // Protected members
+    template <typename E>
+    inline std::size_t ShardedStcpBank<E>::validateStreamId(const int &stream_id)
+    {
+        if (stream_id < 0 || static_cast<std::size_t>(stream_id) >= m_num_streams)
+        {
+            throw std::runtime_error("Stream id is out of range.");
+        }
+        return static_cast<std::size_t>(stream_id);
+    }
+    template <typename E>
+    inline void ShardedStcpBank<E>::scatter(const std::vector<int> &stream_ids,
+                                            const std::vector<double> &xs,
+                                            const std::vector<double> *ns)
+    {
+        for (auto &shard : m_shards)
+        {
+            shard.stream_ids.clear();
+            shard.xs.clear();
+            shard.ns.clear();
+            shard.positions.clear();
+            shard.stopped_positions.clear();
+        }
+        for (std::size_t i = 0; i < xs.size(); i++)
+        {
+            const std::size_t s{static_cast<std::size_t>(stream_ids[i])};
+            Shard &shard{getShard(s)};
+            shard.stream_ids.push_back(toLocalId(s));
+            shard.xs.push_back(xs[i]);
+            if (ns)
+            {
+                shard.ns.push_back((*ns)[i]);
+            }
+            shard.positions.push_back(i);
+        }
+    }
+    template <typename E>
+    inline std::vector<int> ShardedStcpBank<E>::gatherStoppedIds(const std::vector<int> &stream_ids)
+    {
+        // Positions in the whole batch order the alarms as a serial run would.
+        std::vector<std::size_t> stopped_positions;
+        for (auto &shard : m_shards)
+        {
+            for (auto &local_position : shard.stopped_positions)
+            {
+                stopped_positions.push_back(shard.positions[local_position]);
+            }
+        }
+        std::sort(stopped_positions.begin(), stopped_positions.end());
+
+        std::vector<int> newly_stopped_ids;
+        newly_stopped_ids.reserve(stopped_positions.size());
+        for (auto &i : stopped_positions)
+        {
+            newly_stopped_ids.push_back(stream_ids[i]);
+        }
+        return newly_stopped_ids;
+    }
+} // End of namespace stcp
+#endif
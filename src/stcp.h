@@ -5,8 +5,17 @@
 #include "baseline_increment.h"
 #include "log_lr_increment.h"
 #include "log_lr_e.h"
+#include "glrcu_approx_e.h"
 #include "baseline_e.h"
 #include "mix_e.h"
+#include "mix_baseline_e.h"
+#include "stcp_bank.h"
+#include "sharded_stcp_bank.h"
+#include "monte_carlo.h"
+#include "compute_baseline.h"
+#include "normal_cs.h"
+#include "online_cs.h"
+#include "history_summary.h"
 
 namespace stcp
 {
@@ -38,8 +47,26 @@ namespace stcp
             m_is_stopped = false;
             m_time = 0;
             m_stopped_time = 0;
+            m_restart_time = kNegInf;
+            m_alarm_times.clear();
+            m_is_restarted = false;
         }
 
+        // Auto-restart monitoring. If is_auto_restart, every crossing of the threshold
+        // appends the time to the alarm times and resets E, and the observations within
+        // cooldown time after the alarm are discarded, so one vector update over a long
+        // series records all alarms without round trips to R. isStopped and getStoppedTime
+        // still keep the first alarm, so the until-stop methods stop at it.
+        // Histories at an alarm are the log values that crossed the threshold, i.e. before
+        // the restart, and getLogValue returns the log value after the restart.
+        void setAutoRestart(const bool &is_auto_restart, const double &cooldown);
+        bool isAutoRestart() { return m_is_auto_restart; }
+        double getCooldown() { return m_cooldown; }
+        std::vector<double> getAlarmTimes() { return m_alarm_times; }
+        std::size_t getNumAlarms() { return m_alarm_times.size(); }
+        const double *getAlarmTimesData() { return m_alarm_times.data(); }
+        void clearAlarmTimes() { m_alarm_times.clear(); }
+
         void updateLogValue(const double &x) override;
         void updateLogValues(const std::vector<double> &xs) override;
         void updateLogValuesUntilStop(const std::vector<double> &xs) override;
@@ -54,64 +81,168 @@ namespace stcp
         double updateAndReturnHistoryByAvg(const double &x_bar, const double &n) override;
         std::vector<double> updateAndReturnHistoriesByAvgs(const std::vector<double> &x_bars, const std::vector<double> &ns) override;
 
+        // Span versions of the vector methods, which call them with the data of the vectors.
+        // Inputs are checked by the update itself unless a family overrides checkInputs.
+        bool hasInputChecks() override { return false; }
+        void checkInputs(const double *, const std::size_t &) override {}
+        void updateLogValuesBySpan(const double *xs, const std::size_t &n) override;
+        void updateLogValuesUntilStopBySpan(const double *xs, const std::size_t &n) override;
+        void updateAndReturnHistoriesBySpan(const double *xs, const std::size_t &n, double *log_values) override;
+
+        void updateLogValuesByAvgSpans(const double *x_bars, const double *ns, const std::size_t &n) override;
+        void updateLogValuesUntilStopByAvgSpans(const double *x_bars, const double *ns, const std::size_t &n) override;
+        void updateAndReturnHistoriesByAvgSpans(const double *x_bars, const double *ns, const std::size_t &n, double *log_values) override;
+
+        // Same as updateAndReturnHistoriesBySpan, but the log values are passed to summary.add
+        // in chunks of kHistoryChunkSize from a fixed buffer, so the history of a long series
+        // is summarized (see history_summary.h) without storing a log value per observation.
+        template <typename H>
+        void updateAndSummarizeHistoriesBySpan(const double *xs, const std::size_t &n, H &summary);
+
+        // Same as updateAndReturnHistories, but the recursion is evaluated as a parallel scan
+        // over num_threads threads by E::updateLogValuesByScan (mixtures of SR and CU only).
+        // Histories and the stopped time agree with the serial path up to rounding.
+        std::vector<double> updateAndReturnHistoriesByScan(const std::vector<double> &xs, const int &num_threads);
+
+        // Same as updateLogValues with binary inputs 0.0 / 1.0 given by the first num_bits bits
+        // of bytes, least significant bit first (the order of R's packBits).
+        // Runs of E::kMaxPackedBits inputs are applied at once by E::updateLogValueByBitsIfBelow
+        // unless the threshold may be crossed within the run, in which case the run is applied
+        // one by one, so the stopped time is exact.
+        void updateLogValuesByBits(const std::uint8_t *bytes, const std::size_t &num_bits);
+        // Same as above for bits packed in 64-bit words, least significant bit first.
+        void updateLogValuesByWords(const std::uint64_t *words, const std::size_t &num_bits);
+
+        // Stopped times of num_replicates simulated runs of this detector from its initial state,
+        // by stcp::simulateStoppedTimes. Observations up to change_point follow the pre-change
+        // family and params, later ones the post-change ones. Runs not stopped by max_time
+        // return Inf. The state of this object is not changed.
+        std::vector<double> simulateStoppedTimes(const std::string &pre_family,
+                                                 const std::vector<double> &pre_params,
+                                                 const std::string &post_family,
+                                                 const std::vector<double> &post_params,
+                                                 const double &change_point,
+                                                 const double &max_time,
+                                                 const int &num_replicates,
+                                                 const double &seed,
+                                                 const int &num_threads);
+
+        // Binary snapshot of the state (see checkpoint.h): time, stopped state, alarm times
+        // and the state of E, i.e. per-component log values or GLR windows, after the header.
+        // loadState restores it into an object of the same class and configuration,
+        // and leaves the object unchanged if the snapshot is rejected.
+        std::vector<unsigned char> saveState();
+        void loadState(const std::vector<unsigned char> &snapshot);
+        std::uint64_t getConfigHash();
+
     protected:
         E m_e_obj{};
         double m_threshold{log(1.0 / 0.05)}; // Default threshold ues alpha = 0.05.
         double m_time{0.0};
         bool m_is_stopped{false};
         double m_stopped_time{0.0};
+        bool m_is_auto_restart{false};
+        double m_cooldown{0.0};
+        // Observations up to this time are discarded after an alarm.
+        double m_restart_time{kNegInf};
+        std::vector<double> m_alarm_times;
+        // Log value that crossed the threshold if the last update raised an alarm and restarted E.
+        bool m_is_restarted{false};
+        double m_alarm_log_value{0.0};
+
+        // Advance the time by n and record the first crossing of the threshold,
+        // and every crossing in auto-restart monitoring.
+        void updateTimeAndStoppedTime(const double &n);
+        // Log value of the last update reported in histories.
+        double getHistoryLogValue() { return m_is_restarted ? m_alarm_log_value : m_e_obj.getLogValue(); }
+        // get_bits(start, count) returns the count <= 64 bits from the position start,
+        // where start is a multiple of count.
+        template <typename GetBits>
+        void updateLogValuesByPackedBits(const GetBits &get_bits, const std::size_t &num_bits);
     };
 
     // Public members
     template <typename E>
-    inline void Stcp<E>::updateLogValue(const double &x)
+    inline std::vector<unsigned char> Stcp<E>::saveState()
     {
-        m_e_obj.updateLogValue(x);
-        m_time++;
-        if (this->getLogValue() > m_threshold)
+        std::vector<unsigned char> snapshot;
+        SnapshotWriter writer(snapshot);
+        writer.writeHeader(kSnapshotMagic, getConfigHash());
+        writer.write(m_time);
+        writer.write(m_stopped_time);
+        writer.write(static_cast<std::uint8_t>(m_is_stopped));
+        writer.write(m_restart_time);
+        writer.write(static_cast<std::uint64_t>(m_alarm_times.size()));
+        writer.writeArray(m_alarm_times.data(), m_alarm_times.size());
+        m_e_obj.saveState(writer);
+        writer.finish();
+        return snapshot;
+    }
+    template <typename E>
+    inline void Stcp<E>::loadState(const std::vector<unsigned char> &snapshot)
+    {
+        SnapshotReader reader(snapshot.data(), snapshot.size());
+        reader.readHeader(kSnapshotMagic, getConfigHash());
+        const double time{reader.read<double>()};
+        const double stopped_time{reader.read<double>()};
+        const bool is_stopped{reader.read<std::uint8_t>() != 0};
+        const double restart_time{reader.read<double>()};
+        std::vector<double> alarm_times(reader.readCount(reader.getRemainingSize() / sizeof(double)));
+        reader.readArray(alarm_times.data(), alarm_times.size());
+        // The state of E is the rest of the snapshot, and is loaded only if it is complete.
+        m_e_obj.loadState(reader);
+        m_time = time;
+        m_stopped_time = stopped_time;
+        m_is_stopped = is_stopped;
+        m_restart_time = restart_time;
+        m_alarm_times = std::move(alarm_times);
+        m_is_restarted = false;
+    }
+    template <typename E>
+    inline std::uint64_t Stcp<E>::getConfigHash()
+    {
+        ConfigHash hash;
+        hash.add(m_threshold);
+        m_e_obj.hashConfig(hash);
+        return hash.get();
+    }
+
+    template <typename E>
+    inline void Stcp<E>::setAutoRestart(const bool &is_auto_restart, const double &cooldown)
+    {
+        if (!(cooldown >= 0.0) || std::isinf(cooldown))
         {
-            if (!m_is_stopped)
-            {
-                // Record the first stopped time only.
-                m_stopped_time = m_time;
-                m_is_stopped = true;
-            }
+            throw std::runtime_error("cooldown must be a non-negative finite number.");
+        }
+        m_is_auto_restart = is_auto_restart;
+        m_cooldown = cooldown;
+        if (!m_is_auto_restart)
+        {
+            m_restart_time = kNegInf;
         }
     }
+
+    template <typename E>
+    inline void Stcp<E>::updateLogValue(const double &x)
+    {
+        m_e_obj.updateLogValue(x);
+        updateTimeAndStoppedTime(1.0);
+    }
     template <typename E>
     inline void Stcp<E>::updateLogValues(const std::vector<double> &xs)
     {
-        for (auto x : xs)
-        {
-            this->updateLogValue(x);
-        }
+        this->updateLogValuesBySpan(xs.data(), xs.size());
     }
     template <typename E>
     inline void Stcp<E>::updateLogValuesUntilStop(const std::vector<double> &xs)
     {
-        for (auto x : xs)
-        {
-            this->updateLogValue(x);
-            if (m_is_stopped)
-            {
-                break;
-            }
-        }
+        this->updateLogValuesUntilStopBySpan(xs.data(), xs.size());
     }
     template <typename E>
     inline void Stcp<E>::updateLogValueByAvg(const double &x_bar, const double &n)
     {
         m_e_obj.updateLogValueByAvg(x_bar, n);
-        m_time += n;
-        if (this->getLogValue() > m_threshold)
-        {
-            if (!m_is_stopped)
-            {
-                // Record the first stopped time only.
-                m_stopped_time = m_time;
-                m_is_stopped = true;
-            }
-        }
+        updateTimeAndStoppedTime(n);
     }
     template <typename E>
     inline void Stcp<E>::updateLogValuesByAvgs(const std::vector<double> &x_bars, const std::vector<double> &ns)
@@ -120,10 +251,7 @@ namespace stcp
         {
             throw std::runtime_error("x_bars and ns do not have the same length.");
         }
-        for (std::size_t i = 0; i < x_bars.size(); i++)
-        {
-            this->updateLogValueByAvg(x_bars[i], ns[i]);
-        }
+        this->updateLogValuesByAvgSpans(x_bars.data(), ns.data(), x_bars.size());
     }
     template <typename E>
     inline void Stcp<E>::updateLogValuesUntilStopByAvgs(const std::vector<double> &x_bars, const std::vector<double> &ns)
@@ -132,35 +260,25 @@ namespace stcp
         {
             throw std::runtime_error("x_bars and ns do not have the same length.");
         }
-        for (std::size_t i = 0; i < x_bars.size(); i++)
-        {
-            this->updateLogValueByAvg(x_bars[i], ns[i]);
-            if (m_is_stopped)
-            {
-                break;
-            }
-        }
+        this->updateLogValuesUntilStopByAvgSpans(x_bars.data(), ns.data(), x_bars.size());
     }
     template <typename E>
     inline double Stcp<E>::updateAndReturnHistory(const double &x)
     {
         this->updateLogValue(x);
-        return this->getLogValue();
+        return this->getHistoryLogValue();
     }
     template <typename E>
     inline double Stcp<E>::updateAndReturnHistoryByAvg(const double &x_bar, const double &n)
     {
         this->updateLogValueByAvg(x_bar, n);
-        return this->getLogValue();
+        return this->getHistoryLogValue();
     }
     template <typename E>
     inline std::vector<double> Stcp<E>::updateAndReturnHistories(const std::vector<double> &xs)
     {
         std::vector<double> log_values(xs.size());
-        for (std::size_t i = 0; i < xs.size(); i++)
-        {
-            log_values[i] = this->updateAndReturnHistory(xs[i]);
-        }
+        this->updateAndReturnHistoriesBySpan(xs.data(), xs.size(), log_values.data());
         return log_values;
     }
     template <typename E>
@@ -171,11 +289,233 @@ namespace stcp
             throw std::runtime_error("x_bars and ns do not have the same length.");
         }
         std::vector<double> log_values(x_bars.size());
-        for (std::size_t i = 0; i < x_bars.size(); i++)
+        this->updateAndReturnHistoriesByAvgSpans(x_bars.data(), ns.data(), x_bars.size(), log_values.data());
+        return log_values;
+    }
+
+    template <typename E>
+    inline void Stcp<E>::updateLogValuesBySpan(const double *xs, const std::size_t &n)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            this->updateLogValue(xs[i]);
+        }
+    }
+    template <typename E>
+    inline void Stcp<E>::updateLogValuesUntilStopBySpan(const double *xs, const std::size_t &n)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            this->updateLogValue(xs[i]);
+            if (m_is_stopped)
+            {
+                break;
+            }
+        }
+    }
+    template <typename E>
+    inline void Stcp<E>::updateAndReturnHistoriesBySpan(const double *xs, const std::size_t &n, double *log_values)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            log_values[i] = this->updateAndReturnHistory(xs[i]);
+        }
+    }
+    template <typename E>
+    inline void Stcp<E>::updateLogValuesByAvgSpans(const double *x_bars, const double *ns, const std::size_t &n)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            this->updateLogValueByAvg(x_bars[i], ns[i]);
+        }
+    }
+    template <typename E>
+    inline void Stcp<E>::updateLogValuesUntilStopByAvgSpans(const double *x_bars, const double *ns, const std::size_t &n)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            this->updateLogValueByAvg(x_bars[i], ns[i]);
+            if (m_is_stopped)
+            {
+                break;
+            }
+        }
+    }
+    template <typename E>
+    inline void Stcp<E>::updateAndReturnHistoriesByAvgSpans(const double *x_bars, const double *ns, const std::size_t &n, double *log_values)
+    {
+        for (std::size_t i = 0; i < n; i++)
         {
             log_values[i] = this->updateAndReturnHistoryByAvg(x_bars[i], ns[i]);
         }
+    }
+
+    template <typename E>
+    template <typename H>
+    inline void Stcp<E>::updateAndSummarizeHistoriesBySpan(const double *xs, const std::size_t &n, H &summary)
+    {
+        // The span is updated in chunks, so it is checked before the first update.
+        if (this->hasInputChecks())
+        {
+            this->checkInputs(xs, n);
+        }
+        double log_values[kHistoryChunkSize];
+        for (std::size_t start = 0; start < n; start += kHistoryChunkSize)
+        {
+            const std::size_t len{std::min(kHistoryChunkSize, n - start)};
+            this->updateAndReturnHistoriesBySpan(xs + start, len, log_values);
+            summary.add(log_values, len);
+        }
+    }
+
+    template <typename E>
+    inline std::vector<double> Stcp<E>::updateAndReturnHistoriesByScan(const std::vector<double> &xs, const int &num_threads)
+    {
+        // Restarts of auto-restart monitoring are serial.
+        if (num_threads == 1 || m_is_auto_restart)
+        {
+            return this->updateAndReturnHistories(xs);
+        }
+        std::vector<double> log_values(xs.size());
+        WorkerPool pool(num_threads);
+        m_e_obj.updateLogValuesByScan(xs, log_values.data(), pool);
+        for (std::size_t i = 0; i < xs.size() && !m_is_stopped; i++)
+        {
+            if (log_values[i] > m_threshold)
+            {
+                // Record the first stopped time only.
+                m_stopped_time = m_time + static_cast<double>(i + 1);
+                m_is_stopped = true;
+            }
+        }
+        m_time += static_cast<double>(xs.size());
         return log_values;
     }
+
+    template <typename E>
+    inline void Stcp<E>::updateLogValuesByBits(const std::uint8_t *bytes, const std::size_t &num_bits)
+    {
+        updateLogValuesByPackedBits(
+            [bytes](const std::size_t &start, const int &count)
+            {
+                std::uint64_t bits{0};
+                for (int b = 0; b * 8 < count; b++)
+                {
+                    bits |= static_cast<std::uint64_t>(bytes[start / 8 + b]) << (8 * b);
+                }
+                return bits >> (start % 8);
+            },
+            num_bits);
+    }
+    template <typename E>
+    inline void Stcp<E>::updateLogValuesByWords(const std::uint64_t *words, const std::size_t &num_bits)
+    {
+        updateLogValuesByPackedBits(
+            [words](const std::size_t &start, const int &)
+            {
+                return words[start / 64] >> (start % 64);
+            },
+            num_bits);
+    }
+
+    template <typename E>
+    inline std::vector<double> Stcp<E>::simulateStoppedTimes(const std::string &pre_family,
+                                                             const std::vector<double> &pre_params,
+                                                             const std::string &post_family,
+                                                             const std::vector<double> &post_params,
+                                                             const double &change_point,
+                                                             const double &max_time,
+                                                             const int &num_replicates,
+                                                             const double &seed,
+                                                             const int &num_threads)
+    {
+        if (num_replicates <= 0)
+        {
+            throw std::runtime_error("Number of replicates must be strictly positive.");
+        }
+        if (!(max_time >= 1.0) || std::isinf(max_time))
+        {
+            throw std::runtime_error("max_time must be a finite number not less than 1.");
+        }
+        if (!(change_point >= 0.0))
+        {
+            throw std::runtime_error("change_point must be non-negative.");
+        }
+        // Seeds are exactly representable integers, so that R passes them without rounding.
+        if (!(seed >= 0.0 && seed <= 9007199254740992.0) || seed != std::floor(seed))
+        {
+            throw std::runtime_error("seed must be an integer in [0, 2^53].");
+        }
+        const SampleGenerator pre(pre_family, pre_params);
+        const SampleGenerator post(post_family, post_params);
+        return stcp::simulateStoppedTimes(*this,
+                                          pre,
+                                          post,
+                                          change_point,
+                                          max_time,
+                                          static_cast<std::size_t>(num_replicates),
+                                          static_cast<std::uint64_t>(seed),
+                                          num_threads);
+    }
+
+    // Protected members
+    template <typename E>
+    template <typename GetBits>
+    inline void Stcp<E>::updateLogValuesByPackedBits(const GetBits &get_bits, const std::size_t &num_bits)
+    {
+        const int run_size{E::kMaxPackedBits};
+        const std::uint64_t run_mask{run_size == 64 ? ~0ULL : (1ULL << run_size) - 1};
+        std::size_t start{0};
+        for (; start + run_size <= num_bits; start += run_size)
+        {
+            const std::uint64_t bits{get_bits(start, run_size) & run_mask};
+            // Once stopped, the threshold no longer matters unless alarms restart E.
+            // Runs within the cooldown after an alarm are applied one by one to be discarded.
+            if (m_time >= m_restart_time &&
+                m_e_obj.updateLogValueByBitsIfBelow(bits, run_size,
+                                                    m_is_stopped && !m_is_auto_restart ? kPosInf : m_threshold))
+            {
+                m_time += run_size;
+                continue;
+            }
+            for (int j = 0; j < run_size; j++)
+            {
+                this->updateLogValue(static_cast<double>((bits >> j) & 1ULL));
+            }
+        }
+        for (; start < num_bits; start++)
+        {
+            this->updateLogValue(static_cast<double>(get_bits(start, 1) & 1ULL));
+        }
+    }
+    template <typename E>
+    inline void Stcp<E>::updateTimeAndStoppedTime(const double &n)
+    {
+        m_time += n;
+        m_is_restarted = false;
+        if (m_time <= m_restart_time)
+        {
+            // Within the cooldown after an alarm.
+            m_e_obj.reset();
+            return;
+        }
+        if (m_e_obj.isLogValueAbove(m_threshold))
+        {
+            if (!m_is_stopped)
+            {
+                // Record the first stopped time only.
+                m_stopped_time = m_time;
+                m_is_stopped = true;
+            }
+            if (m_is_auto_restart)
+            {
+                m_alarm_times.push_back(m_time);
+                m_alarm_log_value = m_e_obj.getLogValue();
+                m_is_restarted = true;
+                m_e_obj.reset();
+                m_restart_time = m_time + m_cooldown;
+            }
+        }
+    }
 } // End of namespace stcp
 #endif
\ No newline at end of file
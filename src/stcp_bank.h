@@ -0,0 +1,440 @@
+#ifndef STCP_BANK_H
+#define STCP_BANK_H
+
+#include "stcp_interface.h"
+#include "mix_baseline_e.h"
+
+namespace stcp
+{
+    // Bank of mixture detectors for many streams sharing one configuration.
+    // The threshold, weights and baselines are stored once, and the log values
+    // of all streams live in a single array of num_streams x num_components,
+    // so a batch of keyed observations is applied in one pass
+    // without a detector object (or an R-to-C++ call) per stream.
+    template <typename E>
+    class StcpBank
+    {
+        static_assert(std::is_base_of<IGeneralE, E>::value, "Type must be derived from IGeneralE class.");
+
+    public:
+        using L = typename E::BaseType;
+
+        StcpBank();
+        StcpBank(const int &num_streams,
+                 const double &threshold,
+                 const std::vector<L> &base_objs,
+                 const std::vector<double> &weights);
+
+        int getNumStreams() { return static_cast<int>(m_num_streams); }
+        double getThreshold() { return m_threshold; }
+
+        // Per-stream accessors. Stream ids are 0-based indices.
+        double getLogValue(const int &stream_id);
+        bool isStopped(const int &stream_id);
+        double getTime(const int &stream_id);
+        double getStoppedTime(const int &stream_id);
+        void reset(const int &stream_id);
+
+        std::vector<double> getLogValues();
+        std::vector<int> getStoppedIds();
+        void resetAll();
+
+        // xs[i] is an observation of the stream stream_ids[i]. A stream may appear
+        // several times in a batch, and its observations are applied in order.
+        // The whole batch is checked before any stream is updated.
+        // Return ids of the streams crossing the threshold for the first time
+        // in this batch, in the order of crossing.
+        std::vector<int> updateLogValues(const std::vector<int> &stream_ids,
+                                         const std::vector<double> &xs);
+        std::vector<int> updateLogValuesByAvgs(const std::vector<int> &stream_ids,
+                                               const std::vector<double> &x_bars,
+                                               const std::vector<double> &ns);
+
+        // Same as above, but append the positions in the batch of the first crossings
+        // to stopped_positions instead of returning the stream ids, so that the alarms
+        // of several banks can be merged in the order of the batch.
+        void updateLogValuesAndGetStoppedPositions(const std::vector<int> &stream_ids,
+                                                   const std::vector<double> &xs,
+                                                   std::vector<std::size_t> &stopped_positions);
+        void updateLogValuesByAvgsAndGetStoppedPositions(const std::vector<int> &stream_ids,
+                                                         const std::vector<double> &x_bars,
+                                                         const std::vector<double> &ns,
+                                                         std::vector<std::size_t> &stopped_positions);
+
+        // Snapshots of streams (see ShardedStcpBank::saveState). The state of a stream is
+        // its time, stopped time, stopped flag and log values,
+        // getStreamStateSize(k) bytes for k components. Stream ids are 0-based indices and are not checked.
+        static std::size_t getStreamStateSize(const std::size_t &num_components)
+        {
+            return 2 * sizeof(double) + sizeof(std::uint8_t) + num_components * sizeof(double);
+        }
+        std::size_t getNumComponents() const { return m_num_components; }
+        void hashConfig(ConfigHash &hash) const;
+        void saveStreamState(const std::size_t &s, SnapshotWriter &writer) const;
+        void loadStreamState(const std::size_t &s, SnapshotReader &reader);
+
+    protected:
+        std::size_t m_num_streams{0};
+        std::size_t m_num_components{0};
+        double m_threshold{log(1.0 / 0.05)}; // Default threshold uses alpha = 0.05.
+
+        // Parameters shared by all streams.
+        L m_base_obj;
+        std::vector<double> m_lambdas;
+        double m_lambda_min{0.0};
+        double m_lambda_max{0.0};
+        std::vector<double> m_offsets;
+        std::vector<double> m_log_weights;
+        double m_log_num_components{0.0};
+
+        // State of stream s. Its log values are m_log_values[s * k, (s + 1) * k)
+        // for k = m_num_components.
+        std::vector<double> m_log_values;
+        std::vector<double> m_times;
+        std::vector<double> m_stopped_times;
+        std::vector<char> m_is_stopped;
+
+        // Buffers reused across batches so that updates do not allocate
+        // once they have seen the largest batch.
+        std::vector<double> m_ts;
+        std::vector<double> m_log_weighted_values;
+
+        double *getStreamLogValues(const std::size_t &s) { return m_log_values.data() + s * m_num_components; }
+        std::size_t validateStreamId(const int &stream_id);
+        void validateStreamIds(const std::vector<int> &stream_ids);
+        std::vector<double> validateAndComputeLogWeights(const std::vector<double> &weights);
+        double computeLogValue(const std::size_t &s);
+        bool isLogValueAbove(const std::size_t &s);
+        // Advance the time of stream s by n and return true if it is stopped for the first time.
+        bool updateTimeAndStoppedTime(const std::size_t &s, const double &n);
+    };
+
+    // Constructors
+    template <typename E>
+    inline StcpBank<E>::StcpBank()
+        : StcpBank<E>::StcpBank(1,
+                                log(1.0 / 0.05),
+                                std::vector<L>(1),
+                                std::vector<double>{1.0})
+    {
+    }
+    template <typename E>
+    inline StcpBank<E>::StcpBank(const int &num_streams,
+                                 const double &threshold,
+                                 const std::vector<L> &base_objs,
+                                 const std::vector<double> &weights)
+        : m_threshold{threshold},
+          m_log_weights{validateAndComputeLogWeights(weights)}
+    {
+        if (num_streams <= 0)
+        {
+            throw std::runtime_error("Number of streams must be strictly positive.");
+        }
+        if (base_objs.size() != weights.size())
+        {
+            throw std::runtime_error("Baseline objects and Weights do not have the same length.");
+        }
+        m_num_streams = static_cast<std::size_t>(num_streams);
+        m_num_components = base_objs.size();
+        m_base_obj = base_objs[0];
+        m_lambdas.reserve(m_num_components);
+        m_offsets.reserve(m_num_components);
+        for (auto &base_obj : base_objs)
+        {
+            m_lambdas.push_back(base_obj.getLambda());
+            m_offsets.push_back(base_obj.getLogBaseOffset());
+        }
+        m_lambda_min = *std::min_element(m_lambdas.begin(), m_lambdas.end());
+        m_lambda_max = *std::max_element(m_lambdas.begin(), m_lambdas.end());
+        m_log_num_components = std::log(static_cast<double>(m_num_components));
+
+        m_log_values.assign(m_num_streams * m_num_components, E::initialLogValue());
+        m_times.assign(m_num_streams, 0.0);
+        m_stopped_times.assign(m_num_streams, 0.0);
+        m_is_stopped.assign(m_num_streams, 0);
+        m_log_weighted_values.resize(m_num_components);
+    }
+
+    // Public members
+    template <typename E>
+    inline double StcpBank<E>::getLogValue(const int &stream_id)
+    {
+        return computeLogValue(validateStreamId(stream_id));
+    }
+    template <typename E>
+    inline bool StcpBank<E>::isStopped(const int &stream_id)
+    {
+        return m_is_stopped[validateStreamId(stream_id)];
+    }
+    template <typename E>
+    inline double StcpBank<E>::getTime(const int &stream_id)
+    {
+        return m_times[validateStreamId(stream_id)];
+    }
+    template <typename E>
+    inline double StcpBank<E>::getStoppedTime(const int &stream_id)
+    {
+        return m_stopped_times[validateStreamId(stream_id)];
+    }
+    template <typename E>
+    inline void StcpBank<E>::reset(const int &stream_id)
+    {
+        const std::size_t s{validateStreamId(stream_id)};
+        double *log_values{getStreamLogValues(s)};
+        std::fill(log_values, log_values + m_num_components, E::initialLogValue());
+        m_times[s] = 0.0;
+        m_stopped_times[s] = 0.0;
+        m_is_stopped[s] = 0;
+    }
+
+    template <typename E>
+    inline std::vector<double> StcpBank<E>::getLogValues()
+    {
+        std::vector<double> log_values(m_num_streams);
+        for (std::size_t s = 0; s < m_num_streams; s++)
+        {
+            log_values[s] = computeLogValue(s);
+        }
+        return log_values;
+    }
+    template <typename E>
+    inline std::vector<int> StcpBank<E>::getStoppedIds()
+    {
+        std::vector<int> stopped_ids;
+        for (std::size_t s = 0; s < m_num_streams; s++)
+        {
+            if (m_is_stopped[s])
+            {
+                stopped_ids.push_back(static_cast<int>(s));
+            }
+        }
+        return stopped_ids;
+    }
+    template <typename E>
+    inline void StcpBank<E>::resetAll()
+    {
+        std::fill(m_log_values.begin(), m_log_values.end(), E::initialLogValue());
+        std::fill(m_times.begin(), m_times.end(), 0.0);
+        std::fill(m_stopped_times.begin(), m_stopped_times.end(), 0.0);
+        std::fill(m_is_stopped.begin(), m_is_stopped.end(), 0);
+    }
+
+    template <typename E>
+    inline void StcpBank<E>::hashConfig(ConfigHash &hash) const
+    {
+        hash.addType(typeid(StcpBank<E>));
+        m_base_obj.hashParams(hash);
+        hash.add(m_lambdas);
+        hash.add(m_offsets);
+        hash.add(m_log_weights);
+    }
+    template <typename E>
+    inline void StcpBank<E>::saveStreamState(const std::size_t &s, SnapshotWriter &writer) const
+    {
+        writer.write(m_times[s]);
+        writer.write(m_stopped_times[s]);
+        writer.write(static_cast<std::uint8_t>(m_is_stopped[s]));
+        writer.writeArray(m_log_values.data() + s * m_num_components, m_num_components);
+    }
+    template <typename E>
+    inline void StcpBank<E>::loadStreamState(const std::size_t &s, SnapshotReader &reader)
+    {
+        m_times[s] = reader.read<double>();
+        m_stopped_times[s] = reader.read<double>();
+        m_is_stopped[s] = reader.read<std::uint8_t>() != 0;
+        reader.readArray(getStreamLogValues(s), m_num_components);
+    }
+
+    template <typename E>
+    inline std::vector<int> StcpBank<E>::updateLogValues(const std::vector<int> &stream_ids,
+                                                         const std::vector<double> &xs)
+    {
+        std::vector<std::size_t> stopped_positions;
+        updateLogValuesAndGetStoppedPositions(stream_ids, xs, stopped_positions);
+
+        std::vector<int> newly_stopped_ids;
+        newly_stopped_ids.reserve(stopped_positions.size());
+        for (auto &i : stopped_positions)
+        {
+            newly_stopped_ids.push_back(stream_ids[i]);
+        }
+        return newly_stopped_ids;
+    }
+    template <typename E>
+    inline std::vector<int> StcpBank<E>::updateLogValuesByAvgs(const std::vector<int> &stream_ids,
+                                                               const std::vector<double> &x_bars,
+                                                               const std::vector<double> &ns)
+    {
+        std::vector<std::size_t> stopped_positions;
+        updateLogValuesByAvgsAndGetStoppedPositions(stream_ids, x_bars, ns, stopped_positions);
+
+        std::vector<int> newly_stopped_ids;
+        newly_stopped_ids.reserve(stopped_positions.size());
+        for (auto &i : stopped_positions)
+        {
+            newly_stopped_ids.push_back(stream_ids[i]);
+        }
+        return newly_stopped_ids;
+    }
+    template <typename E>
+    inline void StcpBank<E>::updateLogValuesAndGetStoppedPositions(const std::vector<int> &stream_ids,
+                                                                   const std::vector<double> &xs,
+                                                                   std::vector<std::size_t> &stopped_positions)
+    {
+        if (stream_ids.size() != xs.size())
+        {
+            throw std::runtime_error("stream_ids and xs do not have the same length.");
+        }
+        validateStreamIds(stream_ids);
+        // Inputs are checked and transformed once per observation before any update.
+        m_ts.resize(xs.size());
+        for (std::size_t i = 0; i < xs.size(); i++)
+        {
+            m_ts[i] = m_base_obj.transformInput(xs[i]);
+        }
+
+        for (std::size_t i = 0; i < xs.size(); i++)
+        {
+            const std::size_t s{static_cast<std::size_t>(stream_ids[i])};
+            if (L::isKernelInputInRange(m_ts[i], m_lambda_min, m_lambda_max))
+            {
+                MixBaselineKernels<E>::updateLogValues(getStreamLogValues(s),
+                                                       m_lambdas.data(),
+                                                       m_offsets.data(),
+                                                       m_ts[i],
+                                                       m_num_components);
+            }
+            else
+            {
+                MixBaselineKernels<E>::updateLogValuesExact(getStreamLogValues(s),
+                                                            m_lambdas.data(),
+                                                            m_offsets.data(),
+                                                            m_ts[i],
+                                                            m_num_components);
+            }
+            if (updateTimeAndStoppedTime(s, 1.0))
+            {
+                stopped_positions.push_back(i);
+            }
+        }
+    }
+    template <typename E>
+    inline void StcpBank<E>::updateLogValuesByAvgsAndGetStoppedPositions(const std::vector<int> &stream_ids,
+                                                                         const std::vector<double> &x_bars,
+                                                                         const std::vector<double> &ns,
+                                                                         std::vector<std::size_t> &stopped_positions)
+    {
+        if (stream_ids.size() != x_bars.size() || x_bars.size() != ns.size())
+        {
+            throw std::runtime_error("stream_ids, x_bars and ns do not have the same length.");
+        }
+        validateStreamIds(stream_ids);
+
+        for (std::size_t i = 0; i < x_bars.size(); i++)
+        {
+            const std::size_t s{static_cast<std::size_t>(stream_ids[i])};
+            MixBaselineKernels<E>::updateLogValuesByAvg(getStreamLogValues(s),
+                                                        m_lambdas.data(),
+                                                        m_offsets.data(),
+                                                        x_bars[i],
+                                                        ns[i],
+                                                        m_num_components);
+            if (updateTimeAndStoppedTime(s, ns[i]))
+            {
+                stopped_positions.push_back(i);
+            }
+        }
+    }
+
+    // Protected members
+    template <typename E>
+    inline std::size_t StcpBank<E>::validateStreamId(const int &stream_id)
+    {
+        if (stream_id < 0 || static_cast<std::size_t>(stream_id) >= m_num_streams)
+        {
+            throw std::runtime_error("Stream id is out of range.");
+        }
+        return static_cast<std::size_t>(stream_id);
+    }
+    template <typename E>
+    inline void StcpBank<E>::validateStreamIds(const std::vector<int> &stream_ids)
+    {
+        for (auto &stream_id : stream_ids)
+        {
+            validateStreamId(stream_id);
+        }
+    }
+    template <typename E>
+    inline std::vector<double> StcpBank<E>::validateAndComputeLogWeights(const std::vector<double> &weights)
+    {
+        double weights_sum{0.0};
+        std::vector<double> log_weights;
+        log_weights.reserve(weights.size());
+        for (auto &w : weights)
+        {
+            if (w <= 0)
+            {
+                throw std::runtime_error("All weights must be strictly positive.");
+            }
+            weights_sum += w;
+            log_weights.push_back(std::log(w));
+        }
+        if (std::abs(weights_sum - 1.0) > kEps)
+        {
+            throw std::runtime_error("Sum of weights is not equal to 1.");
+        }
+
+        return log_weights;
+    }
+    template <typename E>
+    inline double StcpBank<E>::computeLogValue(const std::size_t &s)
+    {
+        const double *log_values{getStreamLogValues(s)};
+        if (m_num_components == 1)
+        {
+            // Since weight must be equal to 1 by the construction,
+            // we do not need to take account of it.
+            return log_values[0];
+        }
+        const double max_value{
+            MixBaselineKernels<E>::updateLogWeightedValues(m_log_weighted_values.data(),
+                                                           m_log_weights.data(),
+                                                           log_values,
+                                                           m_num_components)};
+        return logSumExpWithMax(m_log_weighted_values.data(), m_num_components, max_value);
+    }
+    template <typename E>
+    inline bool StcpBank<E>::isLogValueAbove(const std::size_t &s)
+    {
+        // max_i(log w_i + log e_i) <= log value <= max_i(log w_i + log e_i) + log k
+        // as in MixBaselineE, so the log-sum-exp is needed only near the threshold.
+        const double max_value{
+            MixBaselineKernels<E>::updateLogWeightedValues(m_log_weighted_values.data(),
+                                                           m_log_weights.data(),
+                                                           getStreamLogValues(s),
+                                                           m_num_components)};
+        if (max_value > m_threshold)
+        {
+            return true;
+        }
+        if (max_value + m_log_num_components <= m_threshold)
+        {
+            return false;
+        }
+        return logSumExpWithMax(m_log_weighted_values.data(), m_num_components, max_value) > m_threshold;
+    }
+    template <typename E>
+    inline bool StcpBank<E>::updateTimeAndStoppedTime(const std::size_t &s, const double &n)
+    {
+        m_times[s] += n;
+        if (m_is_stopped[s] || !isLogValueAbove(s))
+        {
+            return false;
+        }
+        // Record the first stopped time only.
+        m_stopped_times[s] = m_times[s];
+        m_is_stopped[s] = 1;
+        return true;
+    }
+} // End of namespace stcp
+#endif
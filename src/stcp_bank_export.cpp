@@ -0,0 +1,386 @@
+// stcp_bank_export.cpp
+
+#include "stcp_export.h"
+
+#include <Rcpp.h>
+
+RCPP_MODULE(StcpBankSTNormalEx) {
+  using namespace stcp;
+  using GE = ST<Normal>;
+
+  Rcpp::class_<ShardedStcpBank<GE>>("StcpBankSTNormalBase")
+    .constructor()
+
+    .method("getNumStreams", &ShardedStcpBank<GE>::getNumStreams)
+    .method("getThreshold", &ShardedStcpBank<GE>::getThreshold)
+    .method("getNumThreads", &ShardedStcpBank<GE>::getNumThreads)
+    .method("getNumShards", &ShardedStcpBank<GE>::getNumShards)
+    .method("getLogValue", &ShardedStcpBank<GE>::getLogValue)
+    .method("isStopped", &ShardedStcpBank<GE>::isStopped)
+    .method("getTime", &ShardedStcpBank<GE>::getTime)
+    .method("getStoppedTime", &ShardedStcpBank<GE>::getStoppedTime)
+    .method("reset", &ShardedStcpBank<GE>::reset)
+    .method("getLogValues", &ShardedStcpBank<GE>::getLogValues)
+    .method("getStoppedIds", &ShardedStcpBank<GE>::getStoppedIds)
+    .method("resetAll", &ShardedStcpBank<GE>::resetAll)
+    .method("saveState", &ShardedStcpBank<GE>::saveState)
+    .method("loadState", &ShardedStcpBank<GE>::loadState)
+    .method("updateLogValues", &ShardedStcpBank<GE>::updateLogValues)
+    .method("updateLogValuesByAvgs", &ShardedStcpBank<GE>::updateLogValuesByAvgs)
+    ;
+
+  Rcpp::class_<StcpBankNormal<GE>>("StcpBankSTNormal")
+    .derives<ShardedStcpBank<GE>>("StcpBankSTNormalBase")
+    .constructor()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 double>()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 double,
+                 int>()
+    ;
+}
+
+RCPP_MODULE(StcpBankSRNormalEx) {
+  using namespace stcp;
+  using GE = SR<Normal>;
+
+  Rcpp::class_<ShardedStcpBank<GE>>("StcpBankSRNormalBase")
+    .constructor()
+
+    .method("getNumStreams", &ShardedStcpBank<GE>::getNumStreams)
+    .method("getThreshold", &ShardedStcpBank<GE>::getThreshold)
+    .method("getNumThreads", &ShardedStcpBank<GE>::getNumThreads)
+    .method("getNumShards", &ShardedStcpBank<GE>::getNumShards)
+    .method("getLogValue", &ShardedStcpBank<GE>::getLogValue)
+    .method("isStopped", &ShardedStcpBank<GE>::isStopped)
+    .method("getTime", &ShardedStcpBank<GE>::getTime)
+    .method("getStoppedTime", &ShardedStcpBank<GE>::getStoppedTime)
+    .method("reset", &ShardedStcpBank<GE>::reset)
+    .method("getLogValues", &ShardedStcpBank<GE>::getLogValues)
+    .method("getStoppedIds", &ShardedStcpBank<GE>::getStoppedIds)
+    .method("resetAll", &ShardedStcpBank<GE>::resetAll)
+    .method("saveState", &ShardedStcpBank<GE>::saveState)
+    .method("loadState", &ShardedStcpBank<GE>::loadState)
+    .method("updateLogValues", &ShardedStcpBank<GE>::updateLogValues)
+    .method("updateLogValuesByAvgs", &ShardedStcpBank<GE>::updateLogValuesByAvgs)
+    ;
+
+  Rcpp::class_<StcpBankNormal<GE>>("StcpBankSRNormal")
+    .derives<ShardedStcpBank<GE>>("StcpBankSRNormalBase")
+    .constructor()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 double>()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 double,
+                 int>()
+    ;
+}
+
+RCPP_MODULE(StcpBankCUNormalEx) {
+  using namespace stcp;
+  using GE = CU<Normal>;
+
+  Rcpp::class_<ShardedStcpBank<GE>>("StcpBankCUNormalBase")
+    .constructor()
+
+    .method("getNumStreams", &ShardedStcpBank<GE>::getNumStreams)
+    .method("getThreshold", &ShardedStcpBank<GE>::getThreshold)
+    .method("getNumThreads", &ShardedStcpBank<GE>::getNumThreads)
+    .method("getNumShards", &ShardedStcpBank<GE>::getNumShards)
+    .method("getLogValue", &ShardedStcpBank<GE>::getLogValue)
+    .method("isStopped", &ShardedStcpBank<GE>::isStopped)
+    .method("getTime", &ShardedStcpBank<GE>::getTime)
+    .method("getStoppedTime", &ShardedStcpBank<GE>::getStoppedTime)
+    .method("reset", &ShardedStcpBank<GE>::reset)
+    .method("getLogValues", &ShardedStcpBank<GE>::getLogValues)
+    .method("getStoppedIds", &ShardedStcpBank<GE>::getStoppedIds)
+    .method("resetAll", &ShardedStcpBank<GE>::resetAll)
+    .method("saveState", &ShardedStcpBank<GE>::saveState)
+    .method("loadState", &ShardedStcpBank<GE>::loadState)
+    .method("updateLogValues", &ShardedStcpBank<GE>::updateLogValues)
+    .method("updateLogValuesByAvgs", &ShardedStcpBank<GE>::updateLogValuesByAvgs)
+    ;
+
+  Rcpp::class_<StcpBankNormal<GE>>("StcpBankCUNormal")
+    .derives<ShardedStcpBank<GE>>("StcpBankCUNormalBase")
+    .constructor()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 double>()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 double,
+                 int>()
+    ;
+}
+
+RCPP_MODULE(StcpBankSTBerEx) {
+  using namespace stcp;
+  using GE = ST<Ber>;
+
+  Rcpp::class_<ShardedStcpBank<GE>>("StcpBankSTBerBase")
+    .constructor()
+
+    .method("getNumStreams", &ShardedStcpBank<GE>::getNumStreams)
+    .method("getThreshold", &ShardedStcpBank<GE>::getThreshold)
+    .method("getNumThreads", &ShardedStcpBank<GE>::getNumThreads)
+    .method("getNumShards", &ShardedStcpBank<GE>::getNumShards)
+    .method("getLogValue", &ShardedStcpBank<GE>::getLogValue)
+    .method("isStopped", &ShardedStcpBank<GE>::isStopped)
+    .method("getTime", &ShardedStcpBank<GE>::getTime)
+    .method("getStoppedTime", &ShardedStcpBank<GE>::getStoppedTime)
+    .method("reset", &ShardedStcpBank<GE>::reset)
+    .method("getLogValues", &ShardedStcpBank<GE>::getLogValues)
+    .method("getStoppedIds", &ShardedStcpBank<GE>::getStoppedIds)
+    .method("resetAll", &ShardedStcpBank<GE>::resetAll)
+    .method("saveState", &ShardedStcpBank<GE>::saveState)
+    .method("loadState", &ShardedStcpBank<GE>::loadState)
+    .method("updateLogValues", &ShardedStcpBank<GE>::updateLogValues)
+    .method("updateLogValuesByAvgs", &ShardedStcpBank<GE>::updateLogValuesByAvgs)
+    ;
+
+  Rcpp::class_<StcpBankBer<GE>>("StcpBankSTBer")
+    .derives<ShardedStcpBank<GE>>("StcpBankSTBerBase")
+    .constructor()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double>()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 int>()
+    ;
+}
+
+RCPP_MODULE(StcpBankSRBerEx) {
+  using namespace stcp;
+  using GE = SR<Ber>;
+
+  Rcpp::class_<ShardedStcpBank<GE>>("StcpBankSRBerBase")
+    .constructor()
+
+    .method("getNumStreams", &ShardedStcpBank<GE>::getNumStreams)
+    .method("getThreshold", &ShardedStcpBank<GE>::getThreshold)
+    .method("getNumThreads", &ShardedStcpBank<GE>::getNumThreads)
+    .method("getNumShards", &ShardedStcpBank<GE>::getNumShards)
+    .method("getLogValue", &ShardedStcpBank<GE>::getLogValue)
+    .method("isStopped", &ShardedStcpBank<GE>::isStopped)
+    .method("getTime", &ShardedStcpBank<GE>::getTime)
+    .method("getStoppedTime", &ShardedStcpBank<GE>::getStoppedTime)
+    .method("reset", &ShardedStcpBank<GE>::reset)
+    .method("getLogValues", &ShardedStcpBank<GE>::getLogValues)
+    .method("getStoppedIds", &ShardedStcpBank<GE>::getStoppedIds)
+    .method("resetAll", &ShardedStcpBank<GE>::resetAll)
+    .method("saveState", &ShardedStcpBank<GE>::saveState)
+    .method("loadState", &ShardedStcpBank<GE>::loadState)
+    .method("updateLogValues", &ShardedStcpBank<GE>::updateLogValues)
+    .method("updateLogValuesByAvgs", &ShardedStcpBank<GE>::updateLogValuesByAvgs)
+    ;
+
+  Rcpp::class_<StcpBankBer<GE>>("StcpBankSRBer")
+    .derives<ShardedStcpBank<GE>>("StcpBankSRBerBase")
+    .constructor()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double>()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 int>()
+    ;
+}
+
+RCPP_MODULE(StcpBankCUBerEx) {
+  using namespace stcp;
+  using GE = CU<Ber>;
+
+  Rcpp::class_<ShardedStcpBank<GE>>("StcpBankCUBerBase")
+    .constructor()
+
+    .method("getNumStreams", &ShardedStcpBank<GE>::getNumStreams)
+    .method("getThreshold", &ShardedStcpBank<GE>::getThreshold)
+    .method("getNumThreads", &ShardedStcpBank<GE>::getNumThreads)
+    .method("getNumShards", &ShardedStcpBank<GE>::getNumShards)
+    .method("getLogValue", &ShardedStcpBank<GE>::getLogValue)
+    .method("isStopped", &ShardedStcpBank<GE>::isStopped)
+    .method("getTime", &ShardedStcpBank<GE>::getTime)
+    .method("getStoppedTime", &ShardedStcpBank<GE>::getStoppedTime)
+    .method("reset", &ShardedStcpBank<GE>::reset)
+    .method("getLogValues", &ShardedStcpBank<GE>::getLogValues)
+    .method("getStoppedIds", &ShardedStcpBank<GE>::getStoppedIds)
+    .method("resetAll", &ShardedStcpBank<GE>::resetAll)
+    .method("saveState", &ShardedStcpBank<GE>::saveState)
+    .method("loadState", &ShardedStcpBank<GE>::loadState)
+    .method("updateLogValues", &ShardedStcpBank<GE>::updateLogValues)
+    .method("updateLogValuesByAvgs", &ShardedStcpBank<GE>::updateLogValuesByAvgs)
+    ;
+
+  Rcpp::class_<StcpBankBer<GE>>("StcpBankCUBer")
+    .derives<ShardedStcpBank<GE>>("StcpBankCUBerBase")
+    .constructor()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double>()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 int>()
+    ;
+}
+
+RCPP_MODULE(StcpBankSTBoundedEx) {
+  using namespace stcp;
+  using GE = ST<Bounded>;
+
+  Rcpp::class_<ShardedStcpBank<GE>>("StcpBankSTBoundedBase")
+    .constructor()
+
+    .method("getNumStreams", &ShardedStcpBank<GE>::getNumStreams)
+    .method("getThreshold", &ShardedStcpBank<GE>::getThreshold)
+    .method("getNumThreads", &ShardedStcpBank<GE>::getNumThreads)
+    .method("getNumShards", &ShardedStcpBank<GE>::getNumShards)
+    .method("getLogValue", &ShardedStcpBank<GE>::getLogValue)
+    .method("isStopped", &ShardedStcpBank<GE>::isStopped)
+    .method("getTime", &ShardedStcpBank<GE>::getTime)
+    .method("getStoppedTime", &ShardedStcpBank<GE>::getStoppedTime)
+    .method("reset", &ShardedStcpBank<GE>::reset)
+    .method("getLogValues", &ShardedStcpBank<GE>::getLogValues)
+    .method("getStoppedIds", &ShardedStcpBank<GE>::getStoppedIds)
+    .method("resetAll", &ShardedStcpBank<GE>::resetAll)
+    .method("saveState", &ShardedStcpBank<GE>::saveState)
+    .method("loadState", &ShardedStcpBank<GE>::loadState)
+    .method("updateLogValues", &ShardedStcpBank<GE>::updateLogValues)
+    ;
+
+  Rcpp::class_<StcpBankBounded<GE>>("StcpBankSTBounded")
+    .derives<ShardedStcpBank<GE>>("StcpBankSTBoundedBase")
+    .constructor()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double>()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 int>()
+    ;
+}
+
+RCPP_MODULE(StcpBankSRBoundedEx) {
+  using namespace stcp;
+  using GE = SR<Bounded>;
+
+  Rcpp::class_<ShardedStcpBank<GE>>("StcpBankSRBoundedBase")
+    .constructor()
+
+    .method("getNumStreams", &ShardedStcpBank<GE>::getNumStreams)
+    .method("getThreshold", &ShardedStcpBank<GE>::getThreshold)
+    .method("getNumThreads", &ShardedStcpBank<GE>::getNumThreads)
+    .method("getNumShards", &ShardedStcpBank<GE>::getNumShards)
+    .method("getLogValue", &ShardedStcpBank<GE>::getLogValue)
+    .method("isStopped", &ShardedStcpBank<GE>::isStopped)
+    .method("getTime", &ShardedStcpBank<GE>::getTime)
+    .method("getStoppedTime", &ShardedStcpBank<GE>::getStoppedTime)
+    .method("reset", &ShardedStcpBank<GE>::reset)
+    .method("getLogValues", &ShardedStcpBank<GE>::getLogValues)
+    .method("getStoppedIds", &ShardedStcpBank<GE>::getStoppedIds)
+    .method("resetAll", &ShardedStcpBank<GE>::resetAll)
+    .method("saveState", &ShardedStcpBank<GE>::saveState)
+    .method("loadState", &ShardedStcpBank<GE>::loadState)
+    .method("updateLogValues", &ShardedStcpBank<GE>::updateLogValues)
+    ;
+
+  Rcpp::class_<StcpBankBounded<GE>>("StcpBankSRBounded")
+    .derives<ShardedStcpBank<GE>>("StcpBankSRBoundedBase")
+    .constructor()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double>()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 int>()
+    ;
+}
+
+RCPP_MODULE(StcpBankCUBoundedEx) {
+  using namespace stcp;
+  using GE = CU<Bounded>;
+
+  Rcpp::class_<ShardedStcpBank<GE>>("StcpBankCUBoundedBase")
+    .constructor()
+
+    .method("getNumStreams", &ShardedStcpBank<GE>::getNumStreams)
+    .method("getThreshold", &ShardedStcpBank<GE>::getThreshold)
+    .method("getNumThreads", &ShardedStcpBank<GE>::getNumThreads)
+    .method("getNumShards", &ShardedStcpBank<GE>::getNumShards)
+    .method("getLogValue", &ShardedStcpBank<GE>::getLogValue)
+    .method("isStopped", &ShardedStcpBank<GE>::isStopped)
+    .method("getTime", &ShardedStcpBank<GE>::getTime)
+    .method("getStoppedTime", &ShardedStcpBank<GE>::getStoppedTime)
+    .method("reset", &ShardedStcpBank<GE>::reset)
+    .method("getLogValues", &ShardedStcpBank<GE>::getLogValues)
+    .method("getStoppedIds", &ShardedStcpBank<GE>::getStoppedIds)
+    .method("resetAll", &ShardedStcpBank<GE>::resetAll)
+    .method("saveState", &ShardedStcpBank<GE>::saveState)
+    .method("loadState", &ShardedStcpBank<GE>::loadState)
+    .method("updateLogValues", &ShardedStcpBank<GE>::updateLogValues)
+    ;
+
+  Rcpp::class_<StcpBankBounded<GE>>("StcpBankCUBounded")
+    .derives<ShardedStcpBank<GE>>("StcpBankCUBoundedBase")
+    .constructor()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double>()
+    .constructor<int,
+                 double,
+                 std::vector<double>,
+                 std::vector<double>,
+                 double,
+                 int>()
+    ;
+}
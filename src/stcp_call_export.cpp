@@ -0,0 +1,27 @@
+// stcp_call_export.cpp
+
+#include "r_vector_span.h"
+
+#include <Rcpp.h>
+
+// Entry points registered for .Call which update an stcp object by a single observation.
+// They take the external pointer returned by getInterfacePointer() of a module object
+// and numeric scalars, so an online caller skips the method lookup of Rcpp modules and
+// the conversion of a length-1 vector into std::vector<double>.
+// Both return the updated log value.
+
+RcppExport SEXP stcp_update_log_value(SEXP xptr, SEXP x) {
+  BEGIN_RCPP
+  stcp::IStcp *stcp{stcp::getIStcpPointer(xptr)};
+  stcp->updateLogValue(stcp::getScalarInput(x, "x"));
+  return Rf_ScalarReal(stcp->getLogValue());
+  END_RCPP
+}
+
+RcppExport SEXP stcp_update_log_value_by_avg(SEXP xptr, SEXP x_bar, SEXP n) {
+  BEGIN_RCPP
+  stcp::IStcp *stcp{stcp::getIStcpPointer(xptr)};
+  stcp->updateLogValueByAvg(stcp::getScalarInput(x_bar, "x_bar"), stcp::getScalarInput(n, "n"));
+  return Rf_ScalarReal(stcp->getLogValue());
+  END_RCPP
+}
@@ -1,39 +1,88 @@
 // stcp_export.cpp
 
-#include "stcp_export.h"
+#include "r_vector_span.h"
 
 #include <Rcpp.h>
 
+// List of the baseline parameters computed in C++ for compute_baseline in R.
+Rcpp::List computeBaselineCpp(const std::string &family_name,
+                              const double &family_param,
+                              const double &alpha,
+                              const double &delta_lower,
+                              const double &delta_upper,
+                              const double &v_min,
+                              const int &k_max,
+                              const double &tol) {
+  const stcp::BaselineParams params{stcp::computeBaselineCached(
+    family_name, family_param, alpha, delta_lower, delta_upper, v_min, k_max, tol)};
+  return Rcpp::List::create(Rcpp::Named("lambda") = params.lambdas,
+                            Rcpp::Named("omega") = params.omegas,
+                            Rcpp::Named("g_alpha") = params.g_alpha,
+                            Rcpp::Named("k_alpha") = params.k_alpha,
+                            Rcpp::Named("eta_alpha") = params.eta_alpha,
+                            Rcpp::Named("w") = params.w);
+}
+
+// Widths of NormalCS in R at all ns.
+std::vector<double> computeNormalCSWidths(const std::vector<double> &weights,
+                                          const std::vector<double> &lambdas,
+                                          const double &threshold,
+                                          const bool &is_greater,
+                                          const std::vector<double> &ns,
+                                          const int &num_threads) {
+  return stcp::NormalCSWidthSolver(weights, lambdas, threshold, is_greater).computeWidths(ns, num_threads);
+}
+
 RCPP_MODULE(HelperEx) {
   using namespace stcp;
   Rcpp::function("logSumExp", &logSumExp,
            "Compute log-sum-exp of a numeric vector.");
+  Rcpp::function("computeBaselineCpp", &computeBaselineCpp,
+           "Compute baseline parameters of a pre-defined psi family with memoization.");
+  Rcpp::function("computeNormalCSWidths", &computeNormalCSWidths,
+           "Compute widths of the Normal confidence sequence at many sample sizes.");
 }
 
 RCPP_MODULE(StcpMixESTNormalEx) {
   using namespace stcp;
   using GE = ST<Normal>;
 
-  Rcpp::class_<Stcp<MixE<GE>>>("StcpMixESTNormalBase")
+  Rcpp::class_<Stcp<MixBaselineE<GE>>>("StcpMixESTNormalBase")
     .constructor()
   
-    .method("getLogValue", &Stcp<MixE<GE>>::getLogValue)
-    .method("getThreshold", &Stcp<MixE<GE>>::getThreshold)
-    .method("isStopped", &Stcp<MixE<GE>>::isStopped)
-    .method("getTime", &Stcp<MixE<GE>>::getTime)
-    .method("getStoppedTime", &Stcp<MixE<GE>>::getStoppedTime)
-    .method("reset", &Stcp<MixE<GE>>::reset)
-    .method("updateLogValues", &Stcp<MixE<GE>>::updateLogValues)
-    .method("updateLogValuesUntilStop", &Stcp<MixE<GE>>::updateLogValuesUntilStop)
-    .method("updateAndReturnHistories", &Stcp<MixE<GE>>::updateAndReturnHistories)
-    .method("updateLogValuesByAvgs", &Stcp<MixE<GE>>::updateLogValuesByAvgs)
-    .method("updateLogValuesUntilStopByAvgs", &Stcp<MixE<GE>>::updateLogValuesUntilStopByAvgs)
-    .method("updateAndReturnHistoriesByAvgs", &Stcp<MixE<GE>>::updateAndReturnHistoriesByAvgs)
+    .method("getLogValue", &Stcp<MixBaselineE<GE>>::getLogValue)
+    .method("getThreshold", &Stcp<MixBaselineE<GE>>::getThreshold)
+    .method("isStopped", &Stcp<MixBaselineE<GE>>::isStopped)
+    .method("getTime", &Stcp<MixBaselineE<GE>>::getTime)
+    .method("getStoppedTime", &Stcp<MixBaselineE<GE>>::getStoppedTime)
+    .method("reset", &Stcp<MixBaselineE<GE>>::reset)
+    .method("getInterfacePointer", &getInterfacePointerR<Stcp<MixBaselineE<GE>>>)
+    .method("saveState", &Stcp<MixBaselineE<GE>>::saveState)
+    .method("loadState", &Stcp<MixBaselineE<GE>>::loadState)
+    .method("setAutoRestart", &Stcp<MixBaselineE<GE>>::setAutoRestart)
+    .method("isAutoRestart", &Stcp<MixBaselineE<GE>>::isAutoRestart)
+    .method("getAlarmTimes", &Stcp<MixBaselineE<GE>>::getAlarmTimes)
+    .method("clearAlarmTimes", &Stcp<MixBaselineE<GE>>::clearAlarmTimes)
+    .method("updateLogValues", &updateLogValuesFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+    .method("simulateStoppedTimes", &Stcp<MixBaselineE<GE>>::simulateStoppedTimes)
+    .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+    .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<MixBaselineE<GE>>>)
+    .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<MixBaselineE<GE>>>)
     ;
 
     
   Rcpp::class_<StcpNormal<GE>>("StcpMixESTNormal")
-    .derives<Stcp<MixE<GE>>>("StcpMixESTNormalBase")
+    .derives<Stcp<MixBaselineE<GE>>>("StcpMixESTNormalBase")
     .constructor()
     .constructor<double, 
                  std::vector<double>,
@@ -47,26 +96,43 @@ RCPP_MODULE(StcpMixESRNormalEx) {
   using namespace stcp;
   using GE = SR<Normal>;
   
-  Rcpp::class_<Stcp<MixE<GE>>>("StcpMixESRNormalBase")
+  Rcpp::class_<Stcp<MixBaselineE<GE>>>("StcpMixESRNormalBase")
     .constructor()
   
-  .method("getLogValue", &Stcp<MixE<GE>>::getLogValue)
-  .method("getThreshold", &Stcp<MixE<GE>>::getThreshold)
-  .method("isStopped", &Stcp<MixE<GE>>::isStopped)
-  .method("getTime", &Stcp<MixE<GE>>::getTime)
-  .method("getStoppedTime", &Stcp<MixE<GE>>::getStoppedTime)
-  .method("reset", &Stcp<MixE<GE>>::reset)
-  .method("updateLogValues", &Stcp<MixE<GE>>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<MixE<GE>>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<MixE<GE>>::updateAndReturnHistories)
-  .method("updateLogValuesByAvgs", &Stcp<MixE<GE>>::updateLogValuesByAvgs)
-  .method("updateLogValuesUntilStopByAvgs", &Stcp<MixE<GE>>::updateLogValuesUntilStopByAvgs)
-  .method("updateAndReturnHistoriesByAvgs", &Stcp<MixE<GE>>::updateAndReturnHistoriesByAvgs)
+  .method("getLogValue", &Stcp<MixBaselineE<GE>>::getLogValue)
+  .method("getThreshold", &Stcp<MixBaselineE<GE>>::getThreshold)
+  .method("isStopped", &Stcp<MixBaselineE<GE>>::isStopped)
+  .method("getTime", &Stcp<MixBaselineE<GE>>::getTime)
+  .method("getStoppedTime", &Stcp<MixBaselineE<GE>>::getStoppedTime)
+  .method("reset", &Stcp<MixBaselineE<GE>>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<MixBaselineE<GE>>>)
+  .method("saveState", &Stcp<MixBaselineE<GE>>::saveState)
+  .method("loadState", &Stcp<MixBaselineE<GE>>::loadState)
+  .method("setAutoRestart", &Stcp<MixBaselineE<GE>>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<MixBaselineE<GE>>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<MixBaselineE<GE>>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<MixBaselineE<GE>>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("simulateStoppedTimes", &Stcp<MixBaselineE<GE>>::simulateStoppedTimes)
+  .method("updateAndReturnHistoriesByScan", &Stcp<MixBaselineE<GE>>::updateAndReturnHistoriesByScan)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<MixBaselineE<GE>>>)
   ;
   
   
   Rcpp::class_<StcpNormal<GE>>("StcpMixESRNormal")
-    .derives<Stcp<MixE<GE>>>("StcpMixESRNormalBase")
+    .derives<Stcp<MixBaselineE<GE>>>("StcpMixESRNormalBase")
     .constructor()
     .constructor<double, 
   std::vector<double>,
@@ -80,26 +146,43 @@ RCPP_MODULE(StcpMixECUNormalEx) {
   using namespace stcp;
   using GE = CU<Normal>;
   
-  Rcpp::class_<Stcp<MixE<GE>>>("StcpMixECUNormalBase")
+  Rcpp::class_<Stcp<MixBaselineE<GE>>>("StcpMixECUNormalBase")
     .constructor()
   
-  .method("getLogValue", &Stcp<MixE<GE>>::getLogValue)
-  .method("getThreshold", &Stcp<MixE<GE>>::getThreshold)
-  .method("isStopped", &Stcp<MixE<GE>>::isStopped)
-  .method("getTime", &Stcp<MixE<GE>>::getTime)
-  .method("getStoppedTime", &Stcp<MixE<GE>>::getStoppedTime)
-  .method("reset", &Stcp<MixE<GE>>::reset)
-  .method("updateLogValues", &Stcp<MixE<GE>>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<MixE<GE>>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<MixE<GE>>::updateAndReturnHistories)
-  .method("updateLogValuesByAvgs", &Stcp<MixE<GE>>::updateLogValuesByAvgs)
-  .method("updateLogValuesUntilStopByAvgs", &Stcp<MixE<GE>>::updateLogValuesUntilStopByAvgs)
-  .method("updateAndReturnHistoriesByAvgs", &Stcp<MixE<GE>>::updateAndReturnHistoriesByAvgs)
+  .method("getLogValue", &Stcp<MixBaselineE<GE>>::getLogValue)
+  .method("getThreshold", &Stcp<MixBaselineE<GE>>::getThreshold)
+  .method("isStopped", &Stcp<MixBaselineE<GE>>::isStopped)
+  .method("getTime", &Stcp<MixBaselineE<GE>>::getTime)
+  .method("getStoppedTime", &Stcp<MixBaselineE<GE>>::getStoppedTime)
+  .method("reset", &Stcp<MixBaselineE<GE>>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<MixBaselineE<GE>>>)
+  .method("saveState", &Stcp<MixBaselineE<GE>>::saveState)
+  .method("loadState", &Stcp<MixBaselineE<GE>>::loadState)
+  .method("setAutoRestart", &Stcp<MixBaselineE<GE>>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<MixBaselineE<GE>>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<MixBaselineE<GE>>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<MixBaselineE<GE>>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("simulateStoppedTimes", &Stcp<MixBaselineE<GE>>::simulateStoppedTimes)
+  .method("updateAndReturnHistoriesByScan", &Stcp<MixBaselineE<GE>>::updateAndReturnHistoriesByScan)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<MixBaselineE<GE>>>)
   ;
   
   
   Rcpp::class_<StcpNormal<GE>>("StcpMixECUNormal")
-    .derives<Stcp<MixE<GE>>>("StcpMixECUNormalBase")
+    .derives<Stcp<MixBaselineE<GE>>>("StcpMixECUNormalBase")
     .constructor()
     .constructor<double, 
   std::vector<double>,
@@ -113,31 +196,48 @@ RCPP_MODULE(StcpMixESTBerEx) {
   using namespace stcp;
   using GE = ST<Ber>;
   
-  Rcpp::class_<Stcp<MixE<GE>>>("StcpMixESTBerBase")
+  Rcpp::class_<Stcp<MixBaselineE<GE>>>("StcpMixESTBerBase")
     .constructor()
   
-  .method("getLogValue", &Stcp<MixE<GE>>::getLogValue)
-  .method("getThreshold", &Stcp<MixE<GE>>::getThreshold)
-  .method("isStopped", &Stcp<MixE<GE>>::isStopped)
-  .method("getTime", &Stcp<MixE<GE>>::getTime)
-  .method("getStoppedTime", &Stcp<MixE<GE>>::getStoppedTime)
-  .method("reset", &Stcp<MixE<GE>>::reset)
-  .method("updateLogValues", &Stcp<MixE<GE>>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<MixE<GE>>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<MixE<GE>>::updateAndReturnHistories)
-  .method("updateLogValuesByAvgs", &Stcp<MixE<GE>>::updateLogValuesByAvgs)
-  .method("updateLogValuesUntilStopByAvgs", &Stcp<MixE<GE>>::updateLogValuesUntilStopByAvgs)
-  .method("updateAndReturnHistoriesByAvgs", &Stcp<MixE<GE>>::updateAndReturnHistoriesByAvgs)
+  .method("getLogValue", &Stcp<MixBaselineE<GE>>::getLogValue)
+  .method("getThreshold", &Stcp<MixBaselineE<GE>>::getThreshold)
+  .method("isStopped", &Stcp<MixBaselineE<GE>>::isStopped)
+  .method("getTime", &Stcp<MixBaselineE<GE>>::getTime)
+  .method("getStoppedTime", &Stcp<MixBaselineE<GE>>::getStoppedTime)
+  .method("reset", &Stcp<MixBaselineE<GE>>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<MixBaselineE<GE>>>)
+  .method("saveState", &Stcp<MixBaselineE<GE>>::saveState)
+  .method("loadState", &Stcp<MixBaselineE<GE>>::loadState)
+  .method("setAutoRestart", &Stcp<MixBaselineE<GE>>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<MixBaselineE<GE>>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<MixBaselineE<GE>>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<MixBaselineE<GE>>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("simulateStoppedTimes", &Stcp<MixBaselineE<GE>>::simulateStoppedTimes)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<MixBaselineE<GE>>>)
   ;
   
   
   Rcpp::class_<StcpBer<GE>>("StcpMixESTBer")
-    .derives<Stcp<MixE<GE>>>("StcpMixESTBerBase")
+    .derives<Stcp<MixBaselineE<GE>>>("StcpMixESTBerBase")
     .constructor()
     .constructor<double, 
   std::vector<double>,
   std::vector<double>,
   double>()
+    .method("updateLogValuesByBits", &StcpBer<GE>::updateLogValuesByBits)
     ;
   
 }
@@ -146,31 +246,49 @@ RCPP_MODULE(StcpMixESRBerEx) {
   using namespace stcp;
   using GE = SR<Ber>;
   
-  Rcpp::class_<Stcp<MixE<GE>>>("StcpMixESRBerBase")
+  Rcpp::class_<Stcp<MixBaselineE<GE>>>("StcpMixESRBerBase")
     .constructor()
   
-  .method("getLogValue", &Stcp<MixE<GE>>::getLogValue)
-  .method("getThreshold", &Stcp<MixE<GE>>::getThreshold)
-  .method("isStopped", &Stcp<MixE<GE>>::isStopped)
-  .method("getTime", &Stcp<MixE<GE>>::getTime)
-  .method("getStoppedTime", &Stcp<MixE<GE>>::getStoppedTime)
-  .method("reset", &Stcp<MixE<GE>>::reset)
-  .method("updateLogValues", &Stcp<MixE<GE>>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<MixE<GE>>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<MixE<GE>>::updateAndReturnHistories)
-  .method("updateLogValuesByAvgs", &Stcp<MixE<GE>>::updateLogValuesByAvgs)
-  .method("updateLogValuesUntilStopByAvgs", &Stcp<MixE<GE>>::updateLogValuesUntilStopByAvgs)
-  .method("updateAndReturnHistoriesByAvgs", &Stcp<MixE<GE>>::updateAndReturnHistoriesByAvgs)
+  .method("getLogValue", &Stcp<MixBaselineE<GE>>::getLogValue)
+  .method("getThreshold", &Stcp<MixBaselineE<GE>>::getThreshold)
+  .method("isStopped", &Stcp<MixBaselineE<GE>>::isStopped)
+  .method("getTime", &Stcp<MixBaselineE<GE>>::getTime)
+  .method("getStoppedTime", &Stcp<MixBaselineE<GE>>::getStoppedTime)
+  .method("reset", &Stcp<MixBaselineE<GE>>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<MixBaselineE<GE>>>)
+  .method("saveState", &Stcp<MixBaselineE<GE>>::saveState)
+  .method("loadState", &Stcp<MixBaselineE<GE>>::loadState)
+  .method("setAutoRestart", &Stcp<MixBaselineE<GE>>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<MixBaselineE<GE>>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<MixBaselineE<GE>>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<MixBaselineE<GE>>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("simulateStoppedTimes", &Stcp<MixBaselineE<GE>>::simulateStoppedTimes)
+  .method("updateAndReturnHistoriesByScan", &Stcp<MixBaselineE<GE>>::updateAndReturnHistoriesByScan)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<MixBaselineE<GE>>>)
   ;
   
   
   Rcpp::class_<StcpBer<GE>>("StcpMixESRBer")
-    .derives<Stcp<MixE<GE>>>("StcpMixESRBerBase")
+    .derives<Stcp<MixBaselineE<GE>>>("StcpMixESRBerBase")
     .constructor()
     .constructor<double, 
                  std::vector<double>,
                  std::vector<double>,
                  double>()
+    .method("updateLogValuesByBits", &StcpBer<GE>::updateLogValuesByBits)
     ;
   
 }
@@ -179,31 +297,49 @@ RCPP_MODULE(StcpMixECUBerEx) {
   using namespace stcp;
   using GE = CU<Ber>;
   
-  Rcpp::class_<Stcp<MixE<GE>>>("StcpMixECUBerBase")
+  Rcpp::class_<Stcp<MixBaselineE<GE>>>("StcpMixECUBerBase")
     .constructor()
   
-  .method("getLogValue", &Stcp<MixE<GE>>::getLogValue)
-  .method("getThreshold", &Stcp<MixE<GE>>::getThreshold)
-  .method("isStopped", &Stcp<MixE<GE>>::isStopped)
-  .method("getTime", &Stcp<MixE<GE>>::getTime)
-  .method("getStoppedTime", &Stcp<MixE<GE>>::getStoppedTime)
-  .method("reset", &Stcp<MixE<GE>>::reset)
-  .method("updateLogValues", &Stcp<MixE<GE>>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<MixE<GE>>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<MixE<GE>>::updateAndReturnHistories)
-  .method("updateLogValuesByAvgs", &Stcp<MixE<GE>>::updateLogValuesByAvgs)
-  .method("updateLogValuesUntilStopByAvgs", &Stcp<MixE<GE>>::updateLogValuesUntilStopByAvgs)
-  .method("updateAndReturnHistoriesByAvgs", &Stcp<MixE<GE>>::updateAndReturnHistoriesByAvgs)
+  .method("getLogValue", &Stcp<MixBaselineE<GE>>::getLogValue)
+  .method("getThreshold", &Stcp<MixBaselineE<GE>>::getThreshold)
+  .method("isStopped", &Stcp<MixBaselineE<GE>>::isStopped)
+  .method("getTime", &Stcp<MixBaselineE<GE>>::getTime)
+  .method("getStoppedTime", &Stcp<MixBaselineE<GE>>::getStoppedTime)
+  .method("reset", &Stcp<MixBaselineE<GE>>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<MixBaselineE<GE>>>)
+  .method("saveState", &Stcp<MixBaselineE<GE>>::saveState)
+  .method("loadState", &Stcp<MixBaselineE<GE>>::loadState)
+  .method("setAutoRestart", &Stcp<MixBaselineE<GE>>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<MixBaselineE<GE>>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<MixBaselineE<GE>>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<MixBaselineE<GE>>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("simulateStoppedTimes", &Stcp<MixBaselineE<GE>>::simulateStoppedTimes)
+  .method("updateAndReturnHistoriesByScan", &Stcp<MixBaselineE<GE>>::updateAndReturnHistoriesByScan)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<MixBaselineE<GE>>>)
   ;
   
   
   Rcpp::class_<StcpBer<GE>>("StcpMixECUBer")
-    .derives<Stcp<MixE<GE>>>("StcpMixECUBerBase")
+    .derives<Stcp<MixBaselineE<GE>>>("StcpMixECUBerBase")
     .constructor()
     .constructor<double, 
   std::vector<double>,
   std::vector<double>,
   double>()
+    .method("updateLogValuesByBits", &StcpBer<GE>::updateLogValuesByBits)
     ;
   
 }
@@ -212,23 +348,37 @@ RCPP_MODULE(StcpMixESTBoundedrEx) {
   using namespace stcp;
   using GE = ST<Bounded>;
   
-  Rcpp::class_<Stcp<MixE<GE>>>("StcpMixESTBoundedBase")
+  Rcpp::class_<Stcp<MixBaselineE<GE>>>("StcpMixESTBoundedBase")
     .constructor()
   
-  .method("getLogValue", &Stcp<MixE<GE>>::getLogValue)
-  .method("getThreshold", &Stcp<MixE<GE>>::getThreshold)
-  .method("isStopped", &Stcp<MixE<GE>>::isStopped)
-  .method("getTime", &Stcp<MixE<GE>>::getTime)
-  .method("getStoppedTime", &Stcp<MixE<GE>>::getStoppedTime)
-  .method("reset", &Stcp<MixE<GE>>::reset)
-  .method("updateLogValues", &Stcp<MixE<GE>>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<MixE<GE>>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<MixE<GE>>::updateAndReturnHistories)
+  .method("getLogValue", &Stcp<MixBaselineE<GE>>::getLogValue)
+  .method("getThreshold", &Stcp<MixBaselineE<GE>>::getThreshold)
+  .method("isStopped", &Stcp<MixBaselineE<GE>>::isStopped)
+  .method("getTime", &Stcp<MixBaselineE<GE>>::getTime)
+  .method("getStoppedTime", &Stcp<MixBaselineE<GE>>::getStoppedTime)
+  .method("reset", &Stcp<MixBaselineE<GE>>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<MixBaselineE<GE>>>)
+  .method("saveState", &Stcp<MixBaselineE<GE>>::saveState)
+  .method("loadState", &Stcp<MixBaselineE<GE>>::loadState)
+  .method("setAutoRestart", &Stcp<MixBaselineE<GE>>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<MixBaselineE<GE>>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<MixBaselineE<GE>>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<MixBaselineE<GE>>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<MixBaselineE<GE>>>)
+  .method("simulateStoppedTimes", &Stcp<MixBaselineE<GE>>::simulateStoppedTimes)
   ;
   
   
   Rcpp::class_<StcpBounded<GE>>("StcpMixESTBounded")
-    .derives<Stcp<MixE<GE>>>("StcpMixESTBoundedBase")
+    .derives<Stcp<MixBaselineE<GE>>>("StcpMixESTBoundedBase")
     .constructor()
     .constructor<double, 
   std::vector<double>,
@@ -242,23 +392,38 @@ RCPP_MODULE(StcpMixESRBoundedrEx) {
   using namespace stcp;
   using GE = SR<Bounded>;
   
-  Rcpp::class_<Stcp<MixE<GE>>>("StcpMixESRBoundedBase")
+  Rcpp::class_<Stcp<MixBaselineE<GE>>>("StcpMixESRBoundedBase")
     .constructor()
   
-  .method("getLogValue", &Stcp<MixE<GE>>::getLogValue)
-  .method("getThreshold", &Stcp<MixE<GE>>::getThreshold)
-  .method("isStopped", &Stcp<MixE<GE>>::isStopped)
-  .method("getTime", &Stcp<MixE<GE>>::getTime)
-  .method("getStoppedTime", &Stcp<MixE<GE>>::getStoppedTime)
-  .method("reset", &Stcp<MixE<GE>>::reset)
-  .method("updateLogValues", &Stcp<MixE<GE>>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<MixE<GE>>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<MixE<GE>>::updateAndReturnHistories)
+  .method("getLogValue", &Stcp<MixBaselineE<GE>>::getLogValue)
+  .method("getThreshold", &Stcp<MixBaselineE<GE>>::getThreshold)
+  .method("isStopped", &Stcp<MixBaselineE<GE>>::isStopped)
+  .method("getTime", &Stcp<MixBaselineE<GE>>::getTime)
+  .method("getStoppedTime", &Stcp<MixBaselineE<GE>>::getStoppedTime)
+  .method("reset", &Stcp<MixBaselineE<GE>>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<MixBaselineE<GE>>>)
+  .method("saveState", &Stcp<MixBaselineE<GE>>::saveState)
+  .method("loadState", &Stcp<MixBaselineE<GE>>::loadState)
+  .method("setAutoRestart", &Stcp<MixBaselineE<GE>>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<MixBaselineE<GE>>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<MixBaselineE<GE>>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<MixBaselineE<GE>>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<MixBaselineE<GE>>>)
+  .method("simulateStoppedTimes", &Stcp<MixBaselineE<GE>>::simulateStoppedTimes)
+  .method("updateAndReturnHistoriesByScan", &Stcp<MixBaselineE<GE>>::updateAndReturnHistoriesByScan)
   ;
   
   
   Rcpp::class_<StcpBounded<GE>>("StcpMixESRBounded")
-    .derives<Stcp<MixE<GE>>>("StcpMixESRBoundedBase")
+    .derives<Stcp<MixBaselineE<GE>>>("StcpMixESRBoundedBase")
     .constructor()
     .constructor<double, 
                  std::vector<double>,
@@ -272,23 +437,38 @@ RCPP_MODULE(StcpMixECUBoundedrEx) {
   using namespace stcp;
   using GE = CU<Bounded>;
   
-  Rcpp::class_<Stcp<MixE<GE>>>("StcpMixECUBoundedBase")
+  Rcpp::class_<Stcp<MixBaselineE<GE>>>("StcpMixECUBoundedBase")
     .constructor()
   
-  .method("getLogValue", &Stcp<MixE<GE>>::getLogValue)
-  .method("getThreshold", &Stcp<MixE<GE>>::getThreshold)
-  .method("isStopped", &Stcp<MixE<GE>>::isStopped)
-  .method("getTime", &Stcp<MixE<GE>>::getTime)
-  .method("getStoppedTime", &Stcp<MixE<GE>>::getStoppedTime)
-  .method("reset", &Stcp<MixE<GE>>::reset)
-  .method("updateLogValues", &Stcp<MixE<GE>>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<MixE<GE>>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<MixE<GE>>::updateAndReturnHistories)
+  .method("getLogValue", &Stcp<MixBaselineE<GE>>::getLogValue)
+  .method("getThreshold", &Stcp<MixBaselineE<GE>>::getThreshold)
+  .method("isStopped", &Stcp<MixBaselineE<GE>>::isStopped)
+  .method("getTime", &Stcp<MixBaselineE<GE>>::getTime)
+  .method("getStoppedTime", &Stcp<MixBaselineE<GE>>::getStoppedTime)
+  .method("reset", &Stcp<MixBaselineE<GE>>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<MixBaselineE<GE>>>)
+  .method("saveState", &Stcp<MixBaselineE<GE>>::saveState)
+  .method("loadState", &Stcp<MixBaselineE<GE>>::loadState)
+  .method("setAutoRestart", &Stcp<MixBaselineE<GE>>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<MixBaselineE<GE>>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<MixBaselineE<GE>>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<MixBaselineE<GE>>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<MixBaselineE<GE>>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<MixBaselineE<GE>>>)
+  .method("simulateStoppedTimes", &Stcp<MixBaselineE<GE>>::simulateStoppedTimes)
+  .method("updateAndReturnHistoriesByScan", &Stcp<MixBaselineE<GE>>::updateAndReturnHistoriesByScan)
   ;
   
   
   Rcpp::class_<StcpBounded<GE>>("StcpMixECUBounded")
-    .derives<Stcp<MixE<GE>>>("StcpMixECUBoundedBase")
+    .derives<Stcp<MixBaselineE<GE>>>("StcpMixECUBoundedBase")
     .constructor()
     .constructor<double, 
   std::vector<double>,
@@ -6,7 +6,7 @@
 namespace stcp
 {
     template <typename E>
-    class StcpNormal : public Stcp<MixE<E>>
+    class StcpNormal : public Stcp<MixBaselineE<E>>
     {
         static_assert(
             std::is_base_of<ST<Normal>, E>::value ||
@@ -16,7 +16,7 @@ namespace stcp
 
     public:
         StcpNormal()
-            : Stcp<MixE<E>>::Stcp()
+            : Stcp<MixBaselineE<E>>::Stcp()
         {
         }
         StcpNormal(const double &threshold,
@@ -24,21 +24,21 @@ namespace stcp
                    const std::vector<double> &lambdas,
                    const double &mu,
                    const double &sig)
-            : Stcp<MixE<E>>::Stcp()
+            : Stcp<MixBaselineE<E>>::Stcp()
         {
             this->m_threshold = threshold;
-            std::vector<E> e_objs;
-            e_objs.reserve(lambdas.size());
+            std::vector<Normal> base_objs;
+            base_objs.reserve(lambdas.size());
             for (auto lambda : lambdas)
             {
-                e_objs.push_back(E(Normal(lambda, mu, sig)));
+                base_objs.push_back(Normal(lambda, mu, sig));
             }
-            this->m_e_obj = MixE<E>(e_objs, weights);
+            this->m_e_obj = MixBaselineE<E>(base_objs, weights);
         }
     };
 
     template <typename E>
-    class StcpBer : public Stcp<MixE<E>>
+    class StcpBer : public Stcp<MixBaselineE<E>>
     {
         static_assert(
             std::is_base_of<ST<Ber>, E>::value ||
@@ -48,7 +48,7 @@ namespace stcp
 
     public:
         StcpBer()
-            : Stcp<MixE<E>>::Stcp()
+            : Stcp<MixBaselineE<E>>::Stcp()
         {
         }
         StcpBer(
@@ -56,21 +56,32 @@ namespace stcp
             const std::vector<double> &weights,
             const std::vector<double> &lambdas,
             const double &p)
-            : Stcp<MixE<E>>::Stcp()
+            : Stcp<MixBaselineE<E>>::Stcp()
         {
             this->m_threshold = threshold;
-            std::vector<E> e_objs;
-            e_objs.reserve(lambdas.size());
+            std::vector<Ber> base_objs;
+            base_objs.reserve(lambdas.size());
             for (auto lambda : lambdas)
             {
-                e_objs.push_back(E(Ber(lambda, p)));
+                base_objs.push_back(Ber(lambda, p));
             }
-            this->m_e_obj = MixE<E>(e_objs, weights);
+            this->m_e_obj = MixBaselineE<E>(base_objs, weights);
+        }
+
+        // Binary observations packed in a raw vector, least significant bit first.
+        void updateLogValuesByBits(const std::vector<unsigned char> &bytes, const double &num_bits)
+        {
+            // Negated so that NaN, e.g. NA from R, is rejected before the conversion.
+            if (!(num_bits >= 0.0) || num_bits > 8.0 * bytes.size() || num_bits != std::floor(num_bits))
+            {
+                throw std::runtime_error("num_bits must be an integer between 0 and 8 times the number of bytes.");
+            }
+            Stcp<MixBaselineE<E>>::updateLogValuesByBits(bytes.data(), static_cast<std::size_t>(num_bits));
         }
     };
 
     template <typename E>
-    class StcpBounded : public Stcp<MixE<E>>
+    class StcpBounded : public Stcp<MixBaselineE<E>>
     {
         static_assert(
             std::is_base_of<ST<Bounded>, E>::value ||
@@ -80,7 +91,7 @@ namespace stcp
 
     public:
         StcpBounded()
-            : Stcp<MixE<E>>::Stcp()
+            : Stcp<MixBaselineE<E>>::Stcp()
         {
         }
         StcpBounded(
@@ -88,16 +99,205 @@ namespace stcp
             const std::vector<double> &weights,
             const std::vector<double> &lambdas,
             const double &mu)
-            : Stcp<MixE<E>>::Stcp()
+            : Stcp<MixBaselineE<E>>::Stcp()
         {
             this->m_threshold = threshold;
-            std::vector<E> e_objs;
-            e_objs.reserve(lambdas.size());
+            std::vector<Bounded> base_objs;
+            base_objs.reserve(lambdas.size());
+            for (auto lambda : lambdas)
+            {
+                base_objs.push_back(Bounded(lambda, mu));
+            }
+            this->m_e_obj = MixBaselineE<E>(base_objs, weights);
+        }
+
+        // Updates check the whole span for negative inputs before any update
+        // and compute x / mu - 1 once per observation in blocks.
+        bool hasInputChecks() override { return true; }
+        void checkInputs(const double *xs, const std::size_t &n) override
+        {
+            this->m_e_obj.checkInputs(xs, n);
+        }
+        void updateLogValuesBySpan(const double *xs, const std::size_t &n) override
+        {
+            updateLogValuesByBlocks(xs, n, false, nullptr);
+        }
+        void updateLogValuesUntilStopBySpan(const double *xs, const std::size_t &n) override
+        {
+            updateLogValuesByBlocks(xs, n, true, nullptr);
+        }
+        void updateAndReturnHistoriesBySpan(const double *xs, const std::size_t &n, double *log_values) override
+        {
+            updateLogValuesByBlocks(xs, n, false, log_values);
+        }
+
+    protected:
+        void updateLogValuesByBlocks(const double *xs,
+                                     const std::size_t &n,
+                                     const bool &is_until_stop,
+                                     double *log_values)
+        {
+            this->m_e_obj.checkInputs(xs, n);
+            double ts[kInputBlockSize];
+            for (std::size_t start = 0; start < n; start += kInputBlockSize)
+            {
+                const std::size_t len{std::min(kInputBlockSize, n - start)};
+                this->m_e_obj.transformCheckedInputs(xs + start, ts, len);
+                for (std::size_t i = 0; i < len; i++)
+                {
+                    this->m_e_obj.updateLogValueByTransformedInput(ts[i]);
+                    this->updateTimeAndStoppedTime(1.0);
+                    if (log_values)
+                    {
+                        log_values[start + i] = this->getHistoryLogValue();
+                    }
+                    if (is_until_stop && this->m_is_stopped)
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+    };
+
+    template <typename E>
+    class StcpBankNormal : public ShardedStcpBank<E>
+    {
+        static_assert(
+            std::is_base_of<ST<Normal>, E>::value ||
+                std::is_base_of<SR<Normal>, E>::value ||
+                std::is_base_of<CU<Normal>, E>::value,
+            "Type must be derived from BaselineE<Normal> class.");
+
+    public:
+        StcpBankNormal()
+            : ShardedStcpBank<E>::ShardedStcpBank()
+        {
+        }
+        StcpBankNormal(const int &num_streams,
+                       const double &threshold,
+                       const std::vector<double> &weights,
+                       const std::vector<double> &lambdas,
+                       const double &mu,
+                       const double &sig)
+            : StcpBankNormal(num_streams, threshold, weights, lambdas, mu, sig, 1)
+        {
+        }
+        StcpBankNormal(const int &num_streams,
+                       const double &threshold,
+                       const std::vector<double> &weights,
+                       const std::vector<double> &lambdas,
+                       const double &mu,
+                       const double &sig,
+                       const int &num_threads)
+            : ShardedStcpBank<E>::ShardedStcpBank(num_streams, threshold, makeBaseObjs(lambdas, mu, sig), weights, num_threads)
+        {
+        }
+
+    protected:
+        static std::vector<Normal> makeBaseObjs(const std::vector<double> &lambdas,
+                                                const double &mu,
+                                                const double &sig)
+        {
+            std::vector<Normal> base_objs;
+            base_objs.reserve(lambdas.size());
+            for (auto lambda : lambdas)
+            {
+                base_objs.push_back(Normal(lambda, mu, sig));
+            }
+            return base_objs;
+        }
+    };
+
+    template <typename E>
+    class StcpBankBer : public ShardedStcpBank<E>
+    {
+        static_assert(
+            std::is_base_of<ST<Ber>, E>::value ||
+                std::is_base_of<SR<Ber>, E>::value ||
+                std::is_base_of<CU<Ber>, E>::value,
+            "Type must be derived from BaselineE<Ber> class.");
+
+    public:
+        StcpBankBer()
+            : ShardedStcpBank<E>::ShardedStcpBank()
+        {
+        }
+        StcpBankBer(const int &num_streams,
+                    const double &threshold,
+                    const std::vector<double> &weights,
+                    const std::vector<double> &lambdas,
+                    const double &p)
+            : StcpBankBer(num_streams, threshold, weights, lambdas, p, 1)
+        {
+        }
+        StcpBankBer(const int &num_streams,
+                    const double &threshold,
+                    const std::vector<double> &weights,
+                    const std::vector<double> &lambdas,
+                    const double &p,
+                    const int &num_threads)
+            : ShardedStcpBank<E>::ShardedStcpBank(num_streams, threshold, makeBaseObjs(lambdas, p), weights, num_threads)
+        {
+        }
+
+    protected:
+        static std::vector<Ber> makeBaseObjs(const std::vector<double> &lambdas,
+                                             const double &p)
+        {
+            std::vector<Ber> base_objs;
+            base_objs.reserve(lambdas.size());
+            for (auto lambda : lambdas)
+            {
+                base_objs.push_back(Ber(lambda, p));
+            }
+            return base_objs;
+        }
+    };
+
+    template <typename E>
+    class StcpBankBounded : public ShardedStcpBank<E>
+    {
+        static_assert(
+            std::is_base_of<ST<Bounded>, E>::value ||
+                std::is_base_of<SR<Bounded>, E>::value ||
+                std::is_base_of<CU<Bounded>, E>::value,
+            "Type must be derived from BaselineE<Bounded> class.");
+
+    public:
+        StcpBankBounded()
+            : ShardedStcpBank<E>::ShardedStcpBank()
+        {
+        }
+        StcpBankBounded(const int &num_streams,
+                        const double &threshold,
+                        const std::vector<double> &weights,
+                        const std::vector<double> &lambdas,
+                        const double &mu)
+            : StcpBankBounded(num_streams, threshold, weights, lambdas, mu, 1)
+        {
+        }
+        StcpBankBounded(const int &num_streams,
+                        const double &threshold,
+                        const std::vector<double> &weights,
+                        const std::vector<double> &lambdas,
+                        const double &mu,
+                        const int &num_threads)
+            : ShardedStcpBank<E>::ShardedStcpBank(num_streams, threshold, makeBaseObjs(lambdas, mu), weights, num_threads)
+        {
+        }
+
+    protected:
+        static std::vector<Bounded> makeBaseObjs(const std::vector<double> &lambdas,
+                                                 const double &mu)
+        {
+            std::vector<Bounded> base_objs;
+            base_objs.reserve(lambdas.size());
             for (auto lambda : lambdas)
             {
-                e_objs.push_back(E(Bounded(lambda, mu)));
+                base_objs.push_back(Bounded(lambda, mu));
             }
-            this->m_e_obj = MixE<E>(e_objs, weights);
+            return base_objs;
         }
     };
 
@@ -125,10 +325,21 @@ namespace stcp
             this->m_threshold = threshold;
             this->m_e_obj = GLRCU<L>(L(mu, sig), window_size);
         }
+        GLRCUNormal(
+            const double &threshold,
+            const double &mu,
+            const double &sig,
+            const int &window_size,
+            const bool &is_window_in_samples)
+            : Stcp<GLRCU<L>>::Stcp()
+        {
+            this->m_threshold = threshold;
+            this->m_e_obj = GLRCU<L>(L(mu, sig), window_size, is_window_in_samples);
+        }
     };
 
     template <typename L>
-    class GLRCUBer : public Stcp<GLRCU<L>>
+    class GLRCUBer : public Stcp<GLRCUBinary<L>>
     {
         static_assert(
             std::is_base_of<BerGLR, L>::value ||
@@ -138,19 +349,101 @@ namespace stcp
 
     public:
         GLRCUBer()
-            : Stcp<GLRCU<L>>::Stcp()
+            : Stcp<GLRCUBinary<L>>::Stcp()
         {
         }
         GLRCUBer(
             const double &threshold,
             const double &p,
             const int &window_size)
-            : Stcp<GLRCU<L>>::Stcp()
+            : Stcp<GLRCUBinary<L>>::Stcp()
+        {
+            this->m_threshold = threshold;
+            this->m_e_obj = GLRCUBinary<L>(L(p), window_size);
+        }
+        GLRCUBer(
+            const double &threshold,
+            const double &p,
+            const int &window_size,
+            const bool &is_window_in_samples)
+            : Stcp<GLRCUBinary<L>>::Stcp()
         {
             this->m_threshold = threshold;
-            this->m_e_obj = GLRCU<L>(L(p), window_size);
+            this->m_e_obj = GLRCUBinary<L>(L(p), window_size, is_window_in_samples);
         }
     };
 
+    template <typename L>
+    class GLRCUApproxNormal : public Stcp<GLRCUApprox<L>>
+    {
+        static_assert(
+            std::is_base_of<NormalGLR, L>::value ||
+                std::is_base_of<NormalGLRGreater, L>::value ||
+                std::is_base_of<NormalGLRLess, L>::value,
+            "Type must be derived from NormalGLR, NormalGLRGreater or NormalGLRLess.");
+
+    public:
+        GLRCUApproxNormal()
+            : Stcp<GLRCUApprox<L>>::Stcp()
+        {
+        }
+        GLRCUApproxNormal(
+            const double &threshold,
+            const double &mu,
+            const double &sig,
+            const int &window_size,
+            const int &max_buckets_per_size)
+            : Stcp<GLRCUApprox<L>>::Stcp()
+        {
+            this->m_threshold = threshold;
+            this->m_e_obj = GLRCUApprox<L>(L(mu, sig), window_size, max_buckets_per_size);
+        }
+
+        double getLogValueUpperBound() { return this->m_e_obj.getLogValueUpperBound(); }
+    };
+
+    template <typename L>
+    class GLRCUApproxBer : public Stcp<GLRCUApprox<L>>
+    {
+        static_assert(
+            std::is_base_of<BerGLR, L>::value ||
+                std::is_base_of<BerGLRGreater, L>::value ||
+                std::is_base_of<BerGLRLess, L>::value,
+            "Type must be derived from BerGLR, BerGLRGreater or BerGLRLess.");
+
+    public:
+        GLRCUApproxBer()
+            : Stcp<GLRCUApprox<L>>::Stcp()
+        {
+        }
+        GLRCUApproxBer(
+            const double &threshold,
+            const double &p,
+            const int &window_size,
+            const int &max_buckets_per_size)
+            : Stcp<GLRCUApprox<L>>::Stcp()
+        {
+            this->m_threshold = threshold;
+            this->m_e_obj = GLRCUApprox<L>(L(p), window_size, max_buckets_per_size);
+        }
+
+        // GLRCUApprox sums any doubles, so binary inputs are checked here as in GLRCUBinary.
+        void updateLogValue(const double &x) override
+        {
+            double x_bit{0.0};
+            if (std::abs(x - 1.0) < kEps)
+            {
+                x_bit = 1.0;
+            }
+            else if (!(std::abs(x) < kEps))
+            {
+                throw std::runtime_error("Input must be either 0.0 or 1.0 or false or true.");
+            }
+            Stcp<GLRCUApprox<L>>::updateLogValue(x_bit);
+        }
+
+        double getLogValueUpperBound() { return this->m_e_obj.getLogValueUpperBound(); }
+    };
+
 } // End of namespace stcp
 #endif
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 #include <Rcpp.h>
 
-#include "stcp_export.h"
+#include "r_vector_span.h"
 
 RCPP_MODULE(GLRCUNormalEx) {
   using namespace stcp;
@@ -18,9 +18,28 @@ RCPP_MODULE(GLRCUNormalEx) {
   .method("getTime", &Stcp<GE>::getTime)
   .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
   .method("reset", &Stcp<GE>::reset)
-  .method("updateLogValues", &Stcp<GE>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<GE>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<GE>::updateAndReturnHistories)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<GE>>)
   ;
   
   
@@ -28,6 +47,7 @@ RCPP_MODULE(GLRCUNormalEx) {
     .derives<Stcp<GE>>("GLRCUNormalBase")
     .constructor()
     .constructor<double, double, double, int>()
+    .constructor<double, double, double, int, bool>()
   ;
   
 }
@@ -46,9 +66,28 @@ RCPP_MODULE(GLRCUNormalGreaterEx) {
   .method("getTime", &Stcp<GE>::getTime)
   .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
   .method("reset", &Stcp<GE>::reset)
-  .method("updateLogValues", &Stcp<GE>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<GE>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<GE>::updateAndReturnHistories)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<GE>>)
   ;
   
   
@@ -56,6 +95,7 @@ RCPP_MODULE(GLRCUNormalGreaterEx) {
     .derives<Stcp<GE>>("GLRCUNormalGreaterBase")
     .constructor()
     .constructor<double, double, double, int>()
+    .constructor<double, double, double, int, bool>()
   ;
   
 }
@@ -74,9 +114,28 @@ RCPP_MODULE(GLRCUNormalLessEx) {
   .method("getTime", &Stcp<GE>::getTime)
   .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
   .method("reset", &Stcp<GE>::reset)
-  .method("updateLogValues", &Stcp<GE>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<GE>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<GE>::updateAndReturnHistories)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<GE>>)
   ;
   
   
@@ -84,6 +143,7 @@ RCPP_MODULE(GLRCUNormalLessEx) {
     .derives<Stcp<GE>>("GLRCUNormalLessBase")
     .constructor()
     .constructor<double, double, double, int>()
+    .constructor<double, double, double, int, bool>()
   ;
   
 }
@@ -91,7 +151,7 @@ RCPP_MODULE(GLRCUNormalLessEx) {
 RCPP_MODULE(GLRCUBerEx) {
   using namespace stcp;
   using GL = BerGLR;
-  using GE = GLRCU<GL>;
+  using GE = GLRCUBinary<GL>;
   
   Rcpp::class_<Stcp<GE>>("GLRCUBerBase")
     .constructor()
@@ -102,9 +162,28 @@ RCPP_MODULE(GLRCUBerEx) {
   .method("getTime", &Stcp<GE>::getTime)
   .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
   .method("reset", &Stcp<GE>::reset)
-  .method("updateLogValues", &Stcp<GE>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<GE>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<GE>::updateAndReturnHistories)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<GE>>)
   ;
   
   
@@ -112,6 +191,7 @@ RCPP_MODULE(GLRCUBerEx) {
     .derives<Stcp<GE>>("GLRCUBerBase")
     .constructor()
     .constructor<double, double, int>()
+    .constructor<double, double, int, bool>()
   ;
   
 }
@@ -119,7 +199,7 @@ RCPP_MODULE(GLRCUBerEx) {
 RCPP_MODULE(GLRCUBerGreaterEx) {
   using namespace stcp;
   using GL = BerGLRGreater;
-  using GE = GLRCU<GL>;
+  using GE = GLRCUBinary<GL>;
   
   Rcpp::class_<Stcp<GE>>("GLRCUBerGreaterBase")
     .constructor()
@@ -130,9 +210,28 @@ RCPP_MODULE(GLRCUBerGreaterEx) {
   .method("getTime", &Stcp<GE>::getTime)
   .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
   .method("reset", &Stcp<GE>::reset)
-  .method("updateLogValues", &Stcp<GE>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<GE>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<GE>::updateAndReturnHistories)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<GE>>)
   ;
   
   
@@ -140,6 +239,7 @@ RCPP_MODULE(GLRCUBerGreaterEx) {
     .derives<Stcp<GE>>("GLRCUBerGreaterBase")
     .constructor()
     .constructor<double, double, int>()
+    .constructor<double, double, int, bool>()
   ;
   
 }
@@ -147,7 +247,7 @@ RCPP_MODULE(GLRCUBerGreaterEx) {
 RCPP_MODULE(GLRCUBerLessEx) {
   using namespace stcp;
   using GL = BerGLRLess;
-  using GE = GLRCU<GL>;
+  using GE = GLRCUBinary<GL>;
   
   Rcpp::class_<Stcp<GE>>("GLRCUBerLessBase")
     .constructor()
@@ -158,9 +258,28 @@ RCPP_MODULE(GLRCUBerLessEx) {
   .method("getTime", &Stcp<GE>::getTime)
   .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
   .method("reset", &Stcp<GE>::reset)
-  .method("updateLogValues", &Stcp<GE>::updateLogValues)
-  .method("updateLogValuesUntilStop", &Stcp<GE>::updateLogValuesUntilStop)
-  .method("updateAndReturnHistories", &Stcp<GE>::updateAndReturnHistories)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  .method("updateLogValuesByAvgs", &updateLogValuesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStopByAvgs", &updateLogValuesUntilStopByAvgsFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoriesByAvgs", &updateAndReturnHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateAndWriteHistoriesByAvgs", &updateAndWriteHistoriesByAvgsFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("updateLogValuesByAvgsFromFile", &updateLogValuesByAvgsFromFileR<Stcp<GE>>)
   ;
   
   
@@ -168,6 +287,265 @@ RCPP_MODULE(GLRCUBerLessEx) {
     .derives<Stcp<GE>>("GLRCUBerLessBase")
     .constructor()
     .constructor<double, double, int>()
+    .constructor<double, double, int, bool>()
+  ;
+  
+}
+
+RCPP_MODULE(GLRCUApproxNormalEx) {
+  using namespace stcp;
+  using GL = NormalGLR;
+  using GE = GLRCUApprox<GL>;
+  
+  Rcpp::class_<Stcp<GE>>("GLRCUApproxNormalBase")
+    .constructor()
+  
+  .method("getLogValue", &Stcp<GE>::getLogValue)
+  .method("getThreshold", &Stcp<GE>::getThreshold)
+  .method("isStopped", &Stcp<GE>::isStopped)
+  .method("getTime", &Stcp<GE>::getTime)
+  .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
+  .method("reset", &Stcp<GE>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  ;
+  
+  
+  Rcpp::class_<GLRCUApproxNormal<GL>>("GLRCUApproxNormal")
+    .derives<Stcp<GE>>("GLRCUApproxNormalBase")
+    .constructor()
+    .constructor<double, double, double, int, int>()
+    .method("getLogValueUpperBound", &GLRCUApproxNormal<GL>::getLogValueUpperBound)
+  ;
+  
+}
+
+RCPP_MODULE(GLRCUApproxNormalGreaterEx) {
+  using namespace stcp;
+  using GL = NormalGLRGreater;
+  using GE = GLRCUApprox<GL>;
+  
+  Rcpp::class_<Stcp<GE>>("GLRCUApproxNormalGreaterBase")
+    .constructor()
+  
+  .method("getLogValue", &Stcp<GE>::getLogValue)
+  .method("getThreshold", &Stcp<GE>::getThreshold)
+  .method("isStopped", &Stcp<GE>::isStopped)
+  .method("getTime", &Stcp<GE>::getTime)
+  .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
+  .method("reset", &Stcp<GE>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  ;
+  
+  
+  Rcpp::class_<GLRCUApproxNormal<GL>>("GLRCUApproxNormalGreater")
+    .derives<Stcp<GE>>("GLRCUApproxNormalGreaterBase")
+    .constructor()
+    .constructor<double, double, double, int, int>()
+    .method("getLogValueUpperBound", &GLRCUApproxNormal<GL>::getLogValueUpperBound)
+  ;
+  
+}
+
+RCPP_MODULE(GLRCUApproxNormalLessEx) {
+  using namespace stcp;
+  using GL = NormalGLRLess;
+  using GE = GLRCUApprox<GL>;
+  
+  Rcpp::class_<Stcp<GE>>("GLRCUApproxNormalLessBase")
+    .constructor()
+  
+  .method("getLogValue", &Stcp<GE>::getLogValue)
+  .method("getThreshold", &Stcp<GE>::getThreshold)
+  .method("isStopped", &Stcp<GE>::isStopped)
+  .method("getTime", &Stcp<GE>::getTime)
+  .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
+  .method("reset", &Stcp<GE>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  ;
+  
+  
+  Rcpp::class_<GLRCUApproxNormal<GL>>("GLRCUApproxNormalLess")
+    .derives<Stcp<GE>>("GLRCUApproxNormalLessBase")
+    .constructor()
+    .constructor<double, double, double, int, int>()
+    .method("getLogValueUpperBound", &GLRCUApproxNormal<GL>::getLogValueUpperBound)
+  ;
+  
+}
+
+RCPP_MODULE(GLRCUApproxBerEx) {
+  using namespace stcp;
+  using GL = BerGLR;
+  using GE = GLRCUApprox<GL>;
+  
+  Rcpp::class_<Stcp<GE>>("GLRCUApproxBerBase")
+    .constructor()
+  
+  .method("getLogValue", &Stcp<GE>::getLogValue)
+  .method("getThreshold", &Stcp<GE>::getThreshold)
+  .method("isStopped", &Stcp<GE>::isStopped)
+  .method("getTime", &Stcp<GE>::getTime)
+  .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
+  .method("reset", &Stcp<GE>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  ;
+  
+  
+  Rcpp::class_<GLRCUApproxBer<GL>>("GLRCUApproxBer")
+    .derives<Stcp<GE>>("GLRCUApproxBerBase")
+    .constructor()
+    .constructor<double, double, int, int>()
+    .method("getLogValueUpperBound", &GLRCUApproxBer<GL>::getLogValueUpperBound)
   ;
   
-}
\ No newline at end of file
+}
+
+RCPP_MODULE(GLRCUApproxBerGreaterEx) {
+  using namespace stcp;
+  using GL = BerGLRGreater;
+  using GE = GLRCUApprox<GL>;
+  
+  Rcpp::class_<Stcp<GE>>("GLRCUApproxBerGreaterBase")
+    .constructor()
+  
+  .method("getLogValue", &Stcp<GE>::getLogValue)
+  .method("getThreshold", &Stcp<GE>::getThreshold)
+  .method("isStopped", &Stcp<GE>::isStopped)
+  .method("getTime", &Stcp<GE>::getTime)
+  .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
+  .method("reset", &Stcp<GE>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  ;
+  
+  
+  Rcpp::class_<GLRCUApproxBer<GL>>("GLRCUApproxBerGreater")
+    .derives<Stcp<GE>>("GLRCUApproxBerGreaterBase")
+    .constructor()
+    .constructor<double, double, int, int>()
+    .method("getLogValueUpperBound", &GLRCUApproxBer<GL>::getLogValueUpperBound)
+  ;
+  
+}
+
+RCPP_MODULE(GLRCUApproxBerLessEx) {
+  using namespace stcp;
+  using GL = BerGLRLess;
+  using GE = GLRCUApprox<GL>;
+  
+  Rcpp::class_<Stcp<GE>>("GLRCUApproxBerLessBase")
+    .constructor()
+  
+  .method("getLogValue", &Stcp<GE>::getLogValue)
+  .method("getThreshold", &Stcp<GE>::getThreshold)
+  .method("isStopped", &Stcp<GE>::isStopped)
+  .method("getTime", &Stcp<GE>::getTime)
+  .method("getStoppedTime", &Stcp<GE>::getStoppedTime)
+  .method("reset", &Stcp<GE>::reset)
+  .method("getInterfacePointer", &getInterfacePointerR<Stcp<GE>>)
+  .method("saveState", &Stcp<GE>::saveState)
+  .method("loadState", &Stcp<GE>::loadState)
+  .method("setAutoRestart", &Stcp<GE>::setAutoRestart)
+  .method("isAutoRestart", &Stcp<GE>::isAutoRestart)
+  .method("getAlarmTimes", &Stcp<GE>::getAlarmTimes)
+  .method("clearAlarmTimes", &Stcp<GE>::clearAlarmTimes)
+  .method("updateLogValues", &updateLogValuesFromR<Stcp<GE>>)
+  .method("updateLogValuesUntilStop", &updateLogValuesUntilStopFromR<Stcp<GE>>)
+  .method("updateAndReturnAlarmTimes", &updateAndReturnAlarmTimesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistories", &updateAndReturnHistoriesFromR<Stcp<GE>>)
+  .method("updateAndWriteHistories", &updateAndWriteHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnDecimatedHistories", &updateAndReturnDecimatedHistoriesFromR<Stcp<GE>>)
+  .method("updateAndReturnHistoryEnvelopes", &updateAndReturnHistoryEnvelopesFromR<Stcp<GE>>)
+  .method("updateAndReturnNearThresholdHistories", &updateAndReturnNearThresholdHistoriesFromR<Stcp<GE>>)
+  .method("updateLogValuesFromFile", &updateLogValuesFromFileR<Stcp<GE>>)
+  .method("simulateStoppedTimes", &Stcp<GE>::simulateStoppedTimes)
+  ;
+  
+  
+  Rcpp::class_<GLRCUApproxBer<GL>>("GLRCUApproxBerLess")
+    .derives<Stcp<GE>>("GLRCUApproxBerLessBase")
+    .constructor()
+    .constructor<double, double, int, int>()
+    .method("getLogValueUpperBound", &GLRCUApproxBer<GL>::getLogValueUpperBound)
+  ;
+  
+}
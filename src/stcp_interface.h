@@ -9,11 +9,49 @@
 #include <algorithm>
 #include <deque>
 
+#include "fast_math.h"
+#include "checkpoint.h"
+
 namespace stcp
 {
     // Constants and global helper functions
     constexpr double kEps{1e-12};
     constexpr double kNegInf{-std::numeric_limits<double>::infinity()};
+    constexpr double kPosInf{std::numeric_limits<double>::infinity()};
+    constexpr double kLog2{0.69314718055994531};
+    // Array kernels process elements in blocks of this size so that
+    // the block loop is vectorized even by the conservative -O2 cost model.
+    constexpr std::size_t kSimdBlockSize{4};
+    // Batch updates check and transform inputs in blocks of this size
+    // on the stack, so that they do not allocate.
+    constexpr std::size_t kInputBlockSize{256};
+    // Terms smaller than exp(kLogEps) relative to the maximum are
+    // below double precision and can be skipped in log-sum-exp.
+    constexpr double kLogEps{-36.04365338911715}; // log(2^-52)
+    // Largest window length whose max LLR values of binary observations are tabulated.
+    // The triangular table takes (n + 1) * (n + 2) / 2 doubles, about 16MB for 2048.
+    constexpr int kMaxLLRTableWindowSize{2048};
+
+    // Maximum of a and b, which is NaN if either is NaN. Unlike std::max, a running
+    // maximum by it does not drop NaN log values of corrupted states.
+    inline double maxOrNaN(const double &a, const double &b)
+    {
+        return (a > b || std::isnan(a)) ? a : b;
+    }
+
+    // log-sum-exp of n values whose maximum max_x is already known,
+    // which is NaN if max_x is the NaN maximum by maxOrNaN.
+    // It does not allocate, so it can be used in per-observation updates.
+    // The exponentials are evaluated by the vectorized sumExpCentered, which
+    // flushes negligible terms to zero without branching on them.
+    inline double logSumExpWithMax(const double *xs, const std::size_t &n, const double &max_x)
+    {
+        if (max_x == kNegInf || std::isnan(max_x))
+        {
+            return max_x;
+        }
+        return log(sumExpCentered(xs, n, max_x)) + max_x;
+    }
 
     inline double logSumExp(const std::vector<double> &xs)
     {
@@ -21,14 +59,13 @@ namespace stcp
         {
             throw std::runtime_error("Empty vector is not allowed for the logSumExp function.");
         }
-        double max_x = *std::max_element(xs.begin(), xs.end());
-        double sum_exp{0.0};
-        for (auto &x : xs)
+        double max_x{kNegInf};
+        for (const double &x : xs)
         {
-            sum_exp += std::exp(x - max_x);
+            max_x = maxOrNaN(max_x, x);
         }
 
-        return log(sum_exp) + max_x;
+        return logSumExpWithMax(xs.data(), xs.size(), max_x);
     }
 
     // stcp interface classes
@@ -61,6 +98,9 @@ namespace stcp
     {
     public:
         virtual double getLogValue() = 0;
+        // Return true if the log value is strictly larger than the log threshold.
+        // Implementations may avoid computing the exact log value.
+        virtual bool isLogValueAbove(const double &log_threshold) = 0;
         virtual void reset() = 0;
         virtual void updateLogValue(const double &x) = 0;
         virtual void updateLogValueByAvg(const double &x_bar, const double &n)  = 0;
@@ -95,6 +135,21 @@ namespace stcp
         virtual double updateAndReturnHistoryByAvg(const double &x_bar, const double &n) = 0;
         virtual std::vector<double> updateAndReturnHistoriesByAvgs(const std::vector<double> &x_bars, const std::vector<double> &ns) = 0;
 
+        // Same as the vector methods above for n inputs read in place, so that callers
+        // holding the inputs in their own memory (e.g. R vectors) do not copy them.
+        // Long inputs can be passed in consecutive spans; checkInputs throws if any of
+        // the inputs is invalid, so callers can check all spans before the first update
+        // when hasInputChecks() is true.
+        virtual bool hasInputChecks() = 0;
+        virtual void checkInputs(const double *xs, const std::size_t &n) = 0;
+        virtual void updateLogValuesBySpan(const double *xs, const std::size_t &n) = 0;
+        virtual void updateLogValuesUntilStopBySpan(const double *xs, const std::size_t &n) = 0;
+        virtual void updateAndReturnHistoriesBySpan(const double *xs, const std::size_t &n, double *log_values) = 0;
+
+        virtual void updateLogValuesByAvgSpans(const double *x_bars, const double *ns, const std::size_t &n) = 0;
+        virtual void updateLogValuesUntilStopByAvgSpans(const double *x_bars, const double *ns, const std::size_t &n) = 0;
+        virtual void updateAndReturnHistoriesByAvgSpans(const double *x_bars, const double *ns, const std::size_t &n, double *log_values) = 0;
+
         virtual ~IStcp() {}
     };
 } // End of namespace stcp
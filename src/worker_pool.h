@@ -0,0 +1,194 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace stcp
+{
+    // Fixed pool of worker threads running jobs of independent tasks with work stealing.
+    // Each participant (the calling thread and num_threads - 1 workers) owns a queue of tasks.
+    // It pops tasks from the front of its own queue and, once it is empty,
+    // steals from the back of the queues of the others.
+    //
+    // Tasks must not call the R API: run() is called from the R main thread,
+    // which blocks until all tasks are done, and the first exception thrown by a task
+    // is rethrown on the calling thread so that it is translated into an R error there.
+    class WorkerPool
+    {
+    public:
+        explicit WorkerPool(const int &num_threads)
+        {
+            if (num_threads <= 0)
+            {
+                throw std::runtime_error("Number of threads must be strictly positive.");
+            }
+            const std::size_t num_participants{static_cast<std::size_t>(num_threads)};
+            for (std::size_t i = 0; i < num_participants; i++)
+            {
+                m_queues.emplace_back(new TaskQueue());
+            }
+            // The calling thread is the participant 0.
+            for (std::size_t i = 1; i < num_participants; i++)
+            {
+                m_threads.emplace_back(&WorkerPool::workerLoop, this, i);
+            }
+        }
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_is_stopping = true;
+            }
+            m_job_cv.notify_all();
+            for (auto &thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        int getNumThreads() const { return static_cast<int>(m_queues.size()); }
+
+        // Run task(i) for all i in [0, num_tasks) and return after all of them are done.
+        void run(const std::size_t &num_tasks, const std::function<void(std::size_t)> &task)
+        {
+            if (m_threads.empty())
+            {
+                for (std::size_t i = 0; i < num_tasks; i++)
+                {
+                    task(i);
+                }
+                return;
+            }
+            // Contiguous ranges of tasks so that neighbouring tasks stay on one thread
+            // unless they are stolen.
+            const std::size_t num_participants{m_queues.size()};
+            for (std::size_t i = 0; i < num_tasks; i++)
+            {
+                m_queues[i * num_participants / num_tasks]->tasks.push_back(i);
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_task = &task;
+                m_error = nullptr;
+                m_num_busy_workers = m_threads.size();
+                m_generation++;
+            }
+            m_job_cv.notify_all();
+            runTasks(0);
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_done_cv.wait(lock, [this]
+                               { return m_num_busy_workers == 0; });
+                m_task = nullptr;
+            }
+            if (m_error)
+            {
+                std::rethrow_exception(m_error);
+            }
+        }
+
+    private:
+        struct TaskQueue
+        {
+            std::mutex mutex;
+            std::deque<std::size_t> tasks;
+        };
+
+        std::vector<std::unique_ptr<TaskQueue>> m_queues;
+        std::vector<std::thread> m_threads;
+
+        // Job state guarded by m_mutex.
+        std::mutex m_mutex;
+        std::condition_variable m_job_cv;
+        std::condition_variable m_done_cv;
+        const std::function<void(std::size_t)> *m_task{nullptr};
+        std::size_t m_generation{0};
+        std::size_t m_num_busy_workers{0};
+        bool m_is_stopping{false};
+        std::exception_ptr m_error{nullptr};
+
+        void workerLoop(const std::size_t worker_id)
+        {
+            std::size_t seen_generation{0};
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_job_cv.wait(lock, [this, &seen_generation]
+                                  { return m_is_stopping || m_generation != seen_generation; });
+                    if (m_is_stopping)
+                    {
+                        return;
+                    }
+                    seen_generation = m_generation;
+                }
+                runTasks(worker_id);
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (--m_num_busy_workers == 0)
+                    {
+                        m_done_cv.notify_one();
+                    }
+                }
+            }
+        }
+        void runTasks(const std::size_t &participant_id)
+        {
+            std::size_t task_id;
+            while (popTask(participant_id, task_id))
+            {
+                try
+                {
+                    (*m_task)(task_id);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_error)
+                    {
+                        m_error = std::current_exception();
+                    }
+                }
+            }
+        }
+        // All tasks of a job are queued before it starts, so once every queue is empty
+        // no task is left for this participant.
+        bool popTask(const std::size_t &participant_id, std::size_t &task_id)
+        {
+            {
+                TaskQueue &own{*m_queues[participant_id]};
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty())
+                {
+                    task_id = own.tasks.front();
+                    own.tasks.pop_front();
+                    return true;
+                }
+            }
+            const std::size_t num_participants{m_queues.size()};
+            for (std::size_t k = 1; k < num_participants; k++)
+            {
+                TaskQueue &victim{*m_queues[(participant_id + k) % num_participants]};
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty())
+                {
+                    task_id = victim.tasks.back();
+                    victim.tasks.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+} // End of namespace stcp
+#endif